@@ -0,0 +1,41 @@
+# Converts the images in src/assets/images into page-packed SSD1306 headers.
+#
+# Every <name>.bmp or <name>.pbm becomes <name>_image.h in the build tree,
+# declaring the const arrays <name>_pages and <name>_image (ssd1306_image_t),
+# so the data lives in flash and is drawn without parsing.
+
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+# Repository root, so the device and host builds share the same assets
+get_filename_component(PATROGALAXY_ROOT ${CMAKE_CURRENT_LIST_DIR}/.. ABSOLUTE)
+
+function(patrogalaxy_generate_images target)
+  set(GENERATED_DIR ${CMAKE_BINARY_DIR}/generated/images)
+
+  # The headers are generated once and shared by every target using them
+  if (NOT TARGET patrogalaxy_images)
+    set(IMAGE_DIR ${PATROGALAXY_ROOT}/src/assets/images)
+    set(PACK_IMAGE ${PATROGALAXY_ROOT}/tools/pack_image.py)
+
+    file(GLOB IMAGE_SOURCES ${IMAGE_DIR}/*.bmp ${IMAGE_DIR}/*.pbm)
+    file(MAKE_DIRECTORY ${GENERATED_DIR})
+
+    set(GENERATED_HEADERS)
+    foreach(IMAGE ${IMAGE_SOURCES})
+      get_filename_component(NAME ${IMAGE} NAME_WE)
+      set(HEADER ${GENERATED_DIR}/${NAME}_image.h)
+      add_custom_command(
+        OUTPUT ${HEADER}
+        COMMAND Python3::Interpreter ${PACK_IMAGE} ${IMAGE} ${HEADER} ${NAME}
+        DEPENDS ${IMAGE} ${PACK_IMAGE}
+        COMMENT "Packing image ${NAME}"
+      )
+      list(APPEND GENERATED_HEADERS ${HEADER})
+    endforeach()
+
+    add_custom_target(patrogalaxy_images DEPENDS ${GENERATED_HEADERS})
+  endif()
+
+  add_dependencies(${target} patrogalaxy_images)
+  target_include_directories(${target} PRIVATE ${GENERATED_DIR})
+endfunction()
@@ -0,0 +1,77 @@
+/**
+ * @file benchHarness.c
+ * @brief Timing harness shared by the host benchmarks.
+ */
+
+#include "benchHarness.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+double benchNow(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Measures one benchmark and prints its row.
+ * @param benchmark Benchmark to run.
+ */
+static void runBenchmark(const Benchmark *benchmark)
+{
+    // Grow the count until a run is long enough to time reliably
+    uint32_t count = 1;
+    double elapsed = 0;
+    while (count < (1u << 30))
+    {
+        double start = benchNow();
+        benchmark->run(count);
+        elapsed = benchNow() - start;
+        if (elapsed > BENCH_TARGET_SECONDS / 10)
+            break;
+        count *= 2;
+    }
+    count = (uint32_t)(count * (BENCH_TARGET_SECONDS / elapsed)) + 1;
+
+    double best = 0;
+    for (int r = 0; r < BENCH_REPEATS; r++)
+    {
+        double start = benchNow();
+        benchmark->run(count);
+        double seconds = benchNow() - start;
+        if (r == 0 || seconds < best)
+            best = seconds;
+    }
+
+    double nsPerOp = best * 1e9 / count;
+    double throughput = benchmark->unitsPerOp * count / best;
+    const char *prefix = "";
+    if (throughput >= 1e9)
+    {
+        throughput /= 1e9;
+        prefix = "G";
+    }
+    else if (throughput >= 1e6)
+    {
+        throughput /= 1e6;
+        prefix = "M";
+    }
+    else if (throughput >= 1e3)
+    {
+        throughput /= 1e3;
+        prefix = "k";
+    }
+    printf("%-44s %12.1f ns/op %10.2f %s%s/s\n", benchmark->name, nsPerOp, throughput, prefix, benchmark->unit);
+}
+
+void benchRun(const Benchmark *benchmarks, size_t count, const char *filter)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!filter || strstr(benchmarks[i].name, filter))
+            runBenchmark(&benchmarks[i]);
+    }
+}
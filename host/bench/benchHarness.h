@@ -0,0 +1,47 @@
+/**
+ * @file benchHarness.h
+ * @brief Timing harness shared by the host benchmarks.
+ *
+ * Each benchmark runs an operation a number of times. The harness grows
+ * that number until a run is long enough to time, measures a few runs of
+ * about BENCH_TARGET_SECONDS and prints the fastest as a table row.
+ */
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Time each benchmark is measured for, in seconds. */
+#define BENCH_TARGET_SECONDS 0.2
+
+/** @brief Times each benchmark is repeated; the fastest run is reported. */
+#define BENCH_REPEATS 3
+
+/**
+ * @brief A benchmark: runs an operation a number of times.
+ */
+typedef struct
+{
+    const char *name;            /**< Name printed and matched by the filter. */
+    const char *unit;            /**< What the throughput counts. */
+    double unitsPerOp;           /**< Units processed by one operation. */
+    void (*run)(uint32_t count); /**< Runs the operation count times. */
+} Benchmark;
+
+/**
+ * @brief Reads the wall clock.
+ * @return Seconds since an arbitrary point.
+ */
+double benchNow(void);
+
+/**
+ * @brief Measures benchmarks and prints a row for each.
+ * @param benchmarks Benchmarks, in the order they run.
+ * @param count Amount of benchmarks.
+ * @param filter Only run those whose name contains it (NULL: all).
+ */
+void benchRun(const Benchmark *benchmarks, size_t count, const char *filter);
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,403 @@
+/**
+ * @file entityBench.c
+ * @brief Benchmarks of the entity stores at growing entity counts.
+ *
+ * Moves 10, 100 and 1000 asteroids with the update of moveAsteroids, once
+ * laid out as the pooled structure-of-arrays store and once as the array of
+ * int structs the game used before, kept as the reference. Each size runs
+ * with every asteroid alive and with one in four alive: the pool only
+ * visits live slots, the reference tests every struct.
+ *
+ * The asteroids drift vertically and wrap around, so none leaves the screen
+ * and the live count holds steady across runs. The churn rows spawn and
+ * despawn one asteroid in a nearly full store, which the reference does by
+ * scanning for a free struct.
+ *
+ * The collision rows find every bullet and asteroid overlap among 100, 300
+ * and 1000 entities, one in four a bullet, with the broadphase grid and
+ * with the nested loop over every bullet and asteroid it replaced.
+ *
+ * Usage: PatroGalaxyEntityBench [filter]
+ *   filter  only run the benchmarks whose name contains it
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asteroids.h"
+#include "player.h"
+#include "initialize.h"
+#include "benchHarness.h"
+
+/** @brief Most asteroids any benchmark moves. */
+#define BENCH_CAPACITY 1000
+
+/**
+ * @brief An asteroid as it was stored before the entity stores.
+ */
+typedef struct
+{
+    BoundingBox box;
+    int dx;
+    int dy;
+    int active;
+    int angle;
+} ReferenceAsteroid;
+
+/** @brief AsteroidPool, with room for BENCH_CAPACITY asteroids. */
+ENTITY_POOL(BenchPool, benchPool, BENCH_CAPACITY)
+
+/**
+ * @brief AsteroidStore, with room for BENCH_CAPACITY asteroids.
+ */
+typedef struct
+{
+    BenchPool pool;
+    int16_t x[BENCH_CAPACITY];
+    int16_t y[BENCH_CAPACITY];
+    int8_t dx[BENCH_CAPACITY];
+    int8_t dy[BENCH_CAPACITY];
+    uint8_t rotation[BENCH_CAPACITY];
+} BenchAsteroidStore;
+
+/** @brief Asteroids in the reference layout. */
+static ReferenceAsteroid referenceAsteroids[BENCH_CAPACITY];
+/** @brief Asteroids in the store layout. */
+static BenchAsteroidStore storeAsteroids;
+
+/** @brief Speed the asteroids move at (the game's at the start). */
+static const fixed_t speed = FX_ONE + FX_ONE / 4;
+
+/**
+ * @brief Places the same asteroids in both layouts.
+ * @param count Asteroids in use.
+ * @param liveEvery One in this many is alive.
+ */
+static void setup(int count, int liveEvery)
+{
+    srand(1);
+    memset(referenceAsteroids, 0, sizeof(referenceAsteroids));
+    memset(&storeAsteroids, 0, sizeof(storeAsteroids));
+    benchPoolInit(&storeAsteroids.pool);
+    for (int i = 0; i < count; i++)
+    {
+        int x = rand() % SCREEN_WIDTH;
+        int y = rand() % SCREEN_HEIGHT;
+        int dy = rand() % 2 ? 1 : -1;
+        int rotation = rand() % ASTEROID_ROTATIONS;
+        int live = (i % liveEvery) == 0;
+
+        referenceAsteroids[i] = (ReferenceAsteroid){
+            .box = {x, y, ASTEROID_SIZE, ASTEROID_SIZE},
+            .dx = 0,
+            .dy = dy,
+            .active = live,
+            .angle = rotation * ASTEROID_ROTATION_STEP,
+        };
+
+        if (live)
+        {
+            int slot = benchPoolSpawn(&storeAsteroids.pool);
+            storeAsteroids.x[slot] = x;
+            storeAsteroids.y[slot] = y;
+            storeAsteroids.dx[slot] = 0;
+            storeAsteroids.dy[slot] = dy;
+            storeAsteroids.rotation[slot] = rotation;
+        }
+    }
+}
+
+/**
+ * @brief moveAsteroids as it was, over the reference layout.
+ * @param count Asteroids in use.
+ */
+static void moveReference(int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        ReferenceAsteroid *a = &referenceAsteroids[i];
+        if (a->active)
+        {
+            a->box.x = fxToInt(fxFromInt(a->box.x) + a->dx * speed);
+            a->box.y = fxToInt(fxFromInt(a->box.y) + a->dy * speed);
+
+            a->angle += ASTEROID_ROTATION_STEP;
+            a->angle = a->angle % 360;
+
+            if (a->box.x < a->box.w * -1)
+                a->active = 0;
+            if (a->box.y < 0)
+                a->box.y = SCREEN_HEIGHT - 1;
+            if (a->box.y >= SCREEN_HEIGHT)
+                a->box.y = 0;
+        }
+    }
+}
+
+/**
+ * @brief moveAsteroids over the store layout.
+ * @param count Asteroids in use.
+ */
+static void moveStore(int count)
+{
+    BenchAsteroidStore *s = &storeAsteroids;
+    ENTITY_POOL_FOR_EACH(i, &s->pool)
+    {
+        s->x[i] = fxToInt(fxFromInt(s->x[i]) + s->dx[i] * speed);
+        s->y[i] = fxToInt(fxFromInt(s->y[i]) + s->dy[i] * speed);
+
+        s->rotation[i] = s->rotation[i] + 1 < ASTEROID_ROTATIONS ? s->rotation[i] + 1 : 0;
+
+        if (s->x[i] < -ASTEROID_SIZE)
+            benchPoolDespawn(&s->pool, i);
+        if (s->y[i] < 0)
+            s->y[i] = SCREEN_HEIGHT - 1;
+        if (s->y[i] >= SCREEN_HEIGHT)
+            s->y[i] = 0;
+    }
+}
+
+/**
+ * @brief Times updates of one layout.
+ * @param count Updates to run.
+ * @param asteroids Asteroids in use.
+ * @param liveEvery One in this many is alive.
+ * @param move Update of the layout.
+ */
+static void runMoves(uint32_t count, int asteroids, int liveEvery, void (*move)(int))
+{
+    setup(asteroids, liveEvery);
+    for (uint32_t i = 0; i < count; i++)
+        move(asteroids);
+}
+
+/**
+ * @brief Spawns and despawns one asteroid in a full reference array.
+ *
+ * Finds the free struct by scanning, as spawnAsteroid did; the free one is
+ * the last, the worst case.
+ *
+ * @param count Asteroids in use.
+ */
+static void churnReference(int count)
+{
+    referenceAsteroids[count - 1].active = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!referenceAsteroids[i].active)
+        {
+            referenceAsteroids[i].active = 1;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Despawns and spawns one asteroid in a full pool.
+ * @param count Asteroids in use.
+ */
+static void churnStore(int count)
+{
+    benchPoolDespawn(&storeAsteroids.pool, storeAsteroids.pool.dense[count / 2]);
+    benchPoolSpawn(&storeAsteroids.pool);
+}
+
+/** @brief Declares the benchmarks of one asteroid count. */
+#define SIZED_BENCHMARKS(n)                                                                  \
+    static void referenceAll##n(uint32_t count) { runMoves(count, n, 1, moveReference); }     \
+    static void storeAll##n(uint32_t count) { runMoves(count, n, 1, moveStore); }             \
+    static void referenceQuarter##n(uint32_t count) { runMoves(count, n, 4, moveReference); } \
+    static void storeQuarter##n(uint32_t count) { runMoves(count, n, 4, moveStore); }         \
+    static void referenceChurn##n(uint32_t count) { runMoves(count, n, 1, churnReference); }  \
+    static void storeChurn##n(uint32_t count) { runMoves(count, n, 1, churnStore); }
+
+SIZED_BENCHMARKS(10)
+SIZED_BENCHMARKS(100)
+SIZED_BENCHMARKS(1000)
+
+/**
+ * @brief The game's own moveAsteroids, over its MAX_ASTEROIDS store.
+ */
+static void gameMoves(uint32_t count)
+{
+    initAsteroids();
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    {
+        asteroidPoolSpawn(&asteroids.pool);
+        asteroids.dx[i] = 0;
+        asteroids.dy[i] = 1;
+    }
+    for (uint32_t i = 0; i < count; i++)
+        moveAsteroids(speed);
+}
+
+/** @brief Most entities any collision benchmark tests. */
+#define COLLISION_CAPACITY 1000
+/** @brief Room for the pairs of the densest collision benchmark. */
+#define COLLISION_PAIRS (1 << 16)
+
+/** @brief Entities of the collision benchmarks, bullets first. */
+static BoundingBox collisionBoxes[COLLISION_CAPACITY];
+/** @brief Pairs found by the last collision run. */
+static CollisionPair collisionPairs[COLLISION_PAIRS];
+
+static Collider gridColliders[COLLISION_CAPACITY];
+static uint16_t gridOrder[COLLISION_CAPACITY];
+static uint8_t gridCells[COLLISION_CAPACITY];
+static Broadphase grid;
+
+/**
+ * @brief Scatters bullets and asteroids over the screen.
+ * @param count Entities, one in four a bullet.
+ */
+static void setupCollisions(int count)
+{
+    srand(2);
+    for (int i = 0; i < count; i++)
+    {
+        int bullet = i < count / 4;
+        collisionBoxes[i] = (BoundingBox){
+            rand() % SCREEN_WIDTH,
+            rand() % SCREEN_HEIGHT,
+            bullet ? BULLET_WIDTH : ASTEROID_SIZE,
+            bullet ? BULLET_HEIGHT : ASTEROID_SIZE,
+        };
+    }
+    broadphaseInit(&grid, gridColliders, gridOrder, gridCells, COLLISION_CAPACITY);
+}
+
+/**
+ * @brief Finds the overlaps with the nested loop checkBulletsCollisions had.
+ * @param count Entities in use.
+ * @return Pairs found.
+ */
+static int collideReference(int count)
+{
+    int bullets = count / 4;
+    int found = 0;
+    for (int i = 0; i < bullets; i++)
+    {
+        for (int j = bullets; j < count; j++)
+        {
+            if (checkCollision(&collisionBoxes[i], &collisionBoxes[j]) && found < COLLISION_PAIRS)
+            {
+                collisionPairs[found++] = (CollisionPair){COLLIDER_BULLET, COLLIDER_ASTEROID, i, j};
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Finds the overlaps with the broadphase grid.
+ * @param count Entities in use.
+ * @return Pairs found.
+ */
+static int collideGrid(int count)
+{
+    int bullets = count / 4;
+    broadphaseClear(&grid);
+    for (int i = 0; i < count; i++)
+    {
+        if (i < bullets)
+            broadphaseAdd(&grid, collisionBoxes[i], COLLIDER_BULLET, COLLIDER_ASTEROID, i);
+        else
+            broadphaseAdd(&grid, collisionBoxes[i], COLLIDER_ASTEROID, 0, i);
+    }
+    return broadphaseFindPairs(&grid, collisionPairs, COLLISION_PAIRS);
+}
+
+/**
+ * @brief Times collision passes of one method.
+ * @param count Passes to run.
+ * @param entities Entities in use.
+ * @param collide Method to find the overlaps.
+ */
+static void runCollisions(uint32_t count, int entities, int (*collide)(int))
+{
+    setupCollisions(entities);
+    for (uint32_t i = 0; i < count; i++)
+        collide(entities);
+}
+
+/** @brief Declares the collision benchmarks of one entity count. */
+#define COLLISION_BENCHMARKS(n)                                                                      \
+    static void referenceCollide##n(uint32_t count) { runCollisions(count, n, collideReference); } \
+    static void gridCollide##n(uint32_t count) { runCollisions(count, n, collideGrid); }
+
+COLLISION_BENCHMARKS(100)
+COLLISION_BENCHMARKS(300)
+COLLISION_BENCHMARKS(1000)
+
+/**
+ * @brief The game's own collision pass, with every entity alive.
+ */
+static void gameCollisions(uint32_t count)
+{
+    CollisionPair pairs[MAX_COLLISION_PAIRS];
+    initAsteroids();
+    initBullets();
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+        asteroidPoolSpawn(&asteroids.pool);
+    for (int i = 0; i < MAX_BULLETS; i++)
+    {
+        int slot = bulletPoolSpawn(&bullets.pool);
+        bullets.x[slot] = rand() % SCREEN_WIDTH;
+        bullets.y[slot] = rand() % SCREEN_HEIGHT;
+    }
+    for (uint32_t i = 0; i < count; i++)
+        findCollisions(&player, pairs);
+}
+
+/** @brief Every benchmark, in the order they run. */
+static const Benchmark benchmarks[] = {
+    {"moveAsteroids (game store)", "asteroid", MAX_ASTEROIDS, gameMoves},
+    {"move 10, all live (reference: structs)", "asteroid", 10, referenceAll10},
+    {"move 10, all live", "asteroid", 10, storeAll10},
+    {"move 10, 1/4 live (reference: structs)", "asteroid", 10, referenceQuarter10},
+    {"move 10, 1/4 live", "asteroid", 10, storeQuarter10},
+    {"move 100, all live (reference: structs)", "asteroid", 100, referenceAll100},
+    {"move 100, all live", "asteroid", 100, storeAll100},
+    {"move 100, 1/4 live (reference: structs)", "asteroid", 100, referenceQuarter100},
+    {"move 100, 1/4 live", "asteroid", 100, storeQuarter100},
+    {"move 1000, all live (reference: structs)", "asteroid", 1000, referenceAll1000},
+    {"move 1000, all live", "asteroid", 1000, storeAll1000},
+    {"move 1000, 1/4 live (reference: structs)", "asteroid", 1000, referenceQuarter1000},
+    {"move 1000, 1/4 live", "asteroid", 1000, storeQuarter1000},
+    {"spawn+despawn in 10 (reference: scan)", "spawn", 1, referenceChurn10},
+    {"spawn+despawn in 10", "spawn", 1, storeChurn10},
+    {"spawn+despawn in 100 (reference: scan)", "spawn", 1, referenceChurn100},
+    {"spawn+despawn in 100", "spawn", 1, storeChurn100},
+    {"spawn+despawn in 1000 (reference: scan)", "spawn", 1, referenceChurn1000},
+    {"spawn+despawn in 1000", "spawn", 1, storeChurn1000},
+    {"findCollisions (game)", "entity", MAX_COLLIDERS, gameCollisions},
+    {"collide 100 (reference: nested loop)", "entity", 100, referenceCollide100},
+    {"collide 100", "entity", 100, gridCollide100},
+    {"collide 300 (reference: nested loop)", "entity", 300, referenceCollide300},
+    {"collide 300", "entity", 300, gridCollide300},
+    {"collide 1000 (reference: nested loop)", "entity", 1000, referenceCollide1000},
+    {"collide 1000", "entity", 1000, gridCollide1000},
+};
+
+int main(int argc, char **argv)
+{
+    printf("Bytes per asteroid: %.2f in structs, %.2f in the store\n\n",
+           (double)sizeof(ReferenceAsteroid), (double)sizeof(BenchAsteroidStore) / BENCH_CAPACITY);
+
+    // Both collision methods must agree before their times mean anything
+    int sizes[] = {100, 300, 1000};
+    for (int i = 0; i < 3; i++)
+    {
+        setupCollisions(sizes[i]);
+        int nested = collideReference(sizes[i]);
+        int found = collideGrid(sizes[i]);
+        printf("Overlaps among %d entities: %d nested loop, %d grid\n", sizes[i], nested, found);
+        if (nested != found)
+            return 1;
+    }
+    printf("\n");
+
+    benchRun(benchmarks, sizeof(benchmarks) / sizeof(benchmarks[0]), argc > 1 ? argv[1] : NULL);
+    return 0;
+}
@@ -0,0 +1,482 @@
+/**
+ * @file ssd1306Bench.c
+ * @brief Microbenchmarks of the drawing primitives and game screens.
+ *
+ * Runs natively against the framebuffer code of the host build and prints
+ * the time per operation and the throughput of every benchmark. The
+ * "reference" rows are the straightforward versions the driver used
+ * before (per-pixel fills, float line stepping, per-bit glyphs), kept here
+ * as the baseline the optimized paths are measured against.
+ *
+ * Usage: PatroGalaxyBench [filter]
+ *   filter  only run the benchmarks whose name contains it
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "display.h"
+#include "initialize.h"
+#include "asteroids.h"
+#include "background.h"
+#include "player.h"
+#include "sprites.h"
+#include "fixedMath.h"
+#include "main.h"
+#include "hostPlatform.h"
+#include "ifpilogo_image.h"
+#include "benchHarness.h"
+
+/** @brief The driver's 8x5 font (font.h defines it, so it can't be included twice). */
+extern const uint8_t font_8x5[];
+
+/** @brief Amount of precomputed random inputs (power of two). */
+#define INPUTS 1024
+
+/** @brief Random points on the screen. */
+static int32_t pointX[INPUTS], pointY[INPUTS];
+/** @brief Random lines inside the screen. */
+static int32_t lineX1[INPUTS], lineY1[INPUTS], lineX2[INPUTS], lineY2[INPUTS];
+/** @brief Random lines reaching well outside the screen. */
+static int32_t clipX1[INPUTS], clipY1[INPUTS], clipX2[INPUTS], clipY2[INPUTS];
+
+/** @brief The splash logo as a BMP file. */
+static uint8_t *logoBmp = NULL;
+/** @brief Size of the BMP file. */
+static long logoBmpSize = 0;
+
+/** @brief Gameplay snapshot with every asteroid active. */
+static GameFrame gameFrame;
+/** @brief Second snapshot, one step later, for the incremental flush. */
+static GameFrame nextGameFrame;
+
+/** @brief Keeps results alive so the compiler can't drop the work. */
+static volatile int32_t sink;
+
+/**
+ * @brief Random integer in [min, max].
+ */
+static int32_t randomRange(int32_t min, int32_t max)
+{
+    return min + rand() % (max - min + 1);
+}
+
+// References: how the driver drew before the optimized paths
+
+/**
+ * @brief Float-stepped line, as ssd1306_draw_line was.
+ */
+static void referenceFloatLine(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    if (x1 > x2)
+    {
+        int32_t t = x1;
+        x1 = x2;
+        x2 = t;
+        t = y1;
+        y1 = y2;
+        y2 = t;
+    }
+
+    if (x1 == x2)
+    {
+        if (y1 > y2)
+        {
+            int32_t t = y1;
+            y1 = y2;
+            y2 = t;
+        }
+        for (int32_t i = y1; i <= y2; ++i)
+            ssd1306_draw_pixel(p, x1, i);
+        return;
+    }
+
+    float m = (float)(y2 - y1) / (float)(x2 - x1);
+    for (int32_t i = x1; i <= x2; ++i)
+    {
+        float y = m * (float)(i - x1) + (float)y1;
+        ssd1306_draw_pixel(p, i, (uint32_t)y);
+    }
+}
+
+/**
+ * @brief Pixel by pixel rectangle, as ssd1306_draw_square was.
+ */
+static void referencePixelSquare(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    for (uint32_t i = 0; i < width; ++i)
+        for (uint32_t j = 0; j < height; ++j)
+            ssd1306_draw_pixel(p, x + i, y + j);
+}
+
+/**
+ * @brief Bit by bit glyph, as ssd1306_draw_char_with_font was at scale 1.
+ */
+static void referenceBitChar(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *font, char c)
+{
+    if (c < font[3] || c > font[4])
+        return;
+
+    uint32_t partsPerLine = (font[0] >> 3) + ((font[0] & 7) > 0);
+    for (uint8_t w = 0; w < font[1]; ++w)
+    {
+        uint32_t pp = (c - font[3]) * font[1] * partsPerLine + w * partsPerLine + 5;
+        for (uint32_t lp = 0; lp < partsPerLine; ++lp)
+        {
+            uint8_t line = font[pp];
+            for (int8_t j = 0; j < 8; ++j, line >>= 1)
+            {
+                if (line & 1)
+                    ssd1306_draw_pixel(p, x + w, y + (lp << 3) + j);
+            }
+            ++pp;
+        }
+    }
+}
+
+// Primitives
+
+static void benchPixel(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_pixel(&display, pointX[i % INPUTS], pointY[i % INPUTS]);
+}
+
+static void benchLine(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t k = i % INPUTS;
+        ssd1306_draw_line(&display, lineX1[k], lineY1[k], lineX2[k], lineY2[k]);
+    }
+}
+
+static void benchLineReference(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t k = i % INPUTS;
+        referenceFloatLine(&display, lineX1[k], lineY1[k], lineX2[k], lineY2[k]);
+    }
+}
+
+static void benchLineClipped(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t k = i % INPUTS;
+        ssd1306_draw_line(&display, clipX1[k], clipY1[k], clipX2[k], clipY2[k]);
+    }
+}
+
+static void benchClearSquare(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_clear_square(&display, pointX[i % INPUTS] % 112, pointY[i % INPUTS] % 48, 16, 16);
+}
+
+static void benchDrawSquare(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_square(&display, pointX[i % INPUTS] % 112, pointY[i % INPUTS] % 48, 16, 16);
+}
+
+static void benchDrawSquareReference(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        referencePixelSquare(&display, pointX[i % INPUTS] % 112, pointY[i % INPUTS] % 48, 16, 16);
+}
+
+static void benchDrawSquareFull(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_square(&display, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+static void benchDrawSquareFullReference(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        referencePixelSquare(&display, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+static void benchEmptySquare(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_empty_square(&display, pointX[i % INPUTS] % 112, pointY[i % INPUTS] % 48, 16, 16);
+}
+
+/**
+ * @brief Draws "PatroGalaxy" (11 glyphs) at a given scale.
+ */
+static void drawStrings(uint32_t count, uint32_t scale)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_string(&display, pointX[i % INPUTS] % 64, pointY[i % INPUTS] % 48, scale, "PatroGalaxy");
+}
+
+static void benchString1(uint32_t count) { drawStrings(count, 1); }
+static void benchString2(uint32_t count) { drawStrings(count, 2); }
+static void benchString3(uint32_t count) { drawStrings(count, 3); }
+
+static void benchStringReference(uint32_t count)
+{
+    static const char text[] = "PatroGalaxy";
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t x = pointX[i % INPUTS] % 64, y = pointY[i % INPUTS] % 48;
+        for (int c = 0; text[c]; c++)
+            referenceBitChar(&display, x + c * 6, y, font_8x5, text[c]);
+    }
+}
+
+// Images and sprites
+
+static void benchBmpImage(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_bmp_show_image_with_offset(&display, logoBmp, logoBmpSize, 30, 0);
+}
+
+static void benchPackedImage(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_image(&display, &ifpilogo_image, 30, 0);
+}
+
+static void benchPackedImageUnaligned(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_image(&display, &ifpilogo_image, 30, 3);
+}
+
+static void benchSprite(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        ssd1306_draw_sprite(&display, &playerSprite, pointX[i % INPUTS] - 8, pointY[i % INPUTS] - 4);
+}
+
+static void benchAsteroids(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        drawAsteroids(&gameFrame.asteroids);
+}
+
+// Math
+
+static void benchFixedSin(uint32_t count)
+{
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++)
+        sum += fxSin((fixed_t)(i * 4099u));
+    sink = sum;
+}
+
+static void benchFloatSin(uint32_t count)
+{
+    float sum = 0;
+    for (uint32_t i = 0; i < count; i++)
+        sum += sinf((float)(i * 4099u) / 65536.0f);
+    sink = (int32_t)sum;
+}
+
+static void benchDoubleSin(uint32_t count)
+{
+    double sum = 0;
+    for (uint32_t i = 0; i < count; i++)
+        sum += sin((double)(i * 4099u) / 65536.0);
+    sink = (int32_t)sum;
+}
+
+// Screens
+
+static void benchTitle(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        clearDisplay();
+        drawTitleScreen("PatroGalaxy", i % 30, FX_FROM_INT(4), 0, 1);
+    }
+}
+
+static void benchGameplay(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        drawGameFrame(&gameFrame);
+}
+
+static void benchGameOver(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        clearDisplay();
+        drawGameOverScreen();
+    }
+}
+
+// Flush (CPU side only: the bus is the emulated panel)
+
+static void benchShowFull(uint32_t count)
+{
+    drawGameFrame(&gameFrame);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ssd1306_invalidate(&display);
+        ssd1306_show(&display);
+    }
+}
+
+static void benchShowIncremental(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        drawGameFrame(i & 1 ? &nextGameFrame : &gameFrame);
+        ssd1306_show(&display);
+    }
+}
+
+/** @brief Every benchmark, in the order they run. */
+static const Benchmark benchmarks[] = {
+    {"draw_pixel", "pixel", 1, benchPixel},
+    {"draw_line", "line", 1, benchLine},
+    {"draw_line (reference: float)", "line", 1, benchLineReference},
+    {"draw_line clipped", "line", 1, benchLineClipped},
+    {"clear_square 16x16", "pixel", 256, benchClearSquare},
+    {"draw_square 16x16", "pixel", 256, benchDrawSquare},
+    {"draw_square 16x16 (reference: per pixel)", "pixel", 256, benchDrawSquareReference},
+    {"draw_square 128x64", "pixel", 8192, benchDrawSquareFull},
+    {"draw_square 128x64 (reference: per pixel)", "pixel", 8192, benchDrawSquareFullReference},
+    {"draw_empty_square 16x16", "square", 1, benchEmptySquare},
+    {"draw_string scale 1", "glyph", 11, benchString1},
+    {"draw_string scale 1 (reference: per bit)", "glyph", 11, benchStringReference},
+    {"draw_string scale 2", "glyph", 11, benchString2},
+    {"draw_string scale 3", "glyph", 11, benchString3},
+    {"bmp_show_image_with_offset 74x64", "image", 1, benchBmpImage},
+    {"draw_image 74x64", "image", 1, benchPackedImage},
+    {"draw_image 74x64 unaligned", "image", 1, benchPackedImageUnaligned},
+    {"draw_sprite player", "sprite", 1, benchSprite},
+    {"drawAsteroids x10", "sprite", MAX_ASTEROIDS, benchAsteroids},
+    {"fxSin", "call", 1, benchFixedSin},
+    {"sinf", "call", 1, benchFloatSin},
+    {"sin", "call", 1, benchDoubleSin},
+    {"frame: title", "frame", 1, benchTitle},
+    {"frame: gameplay, 10 asteroids", "frame", 1, benchGameplay},
+    {"frame: game over", "frame", 1, benchGameOver},
+    {"show: full refresh", "frame", 1, benchShowFull},
+    {"show: gameplay redraw + incremental", "frame", 1, benchShowIncremental},
+};
+
+/**
+ * @brief Reads the splash logo BMP from the assets.
+ */
+static void loadLogo(void)
+{
+    FILE *file = fopen(PATROGALAXY_ASSET_DIR "/images/ifpilogo.bmp", "rb");
+    if (!file)
+    {
+        printf("cannot open ifpilogo.bmp\n");
+        exit(1);
+    }
+    fseek(file, 0, SEEK_END);
+    logoBmpSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    logoBmp = malloc(logoBmpSize);
+    if (fread(logoBmp, 1, logoBmpSize, file) != (size_t)logoBmpSize)
+    {
+        printf("cannot read ifpilogo.bmp\n");
+        exit(1);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Fills the random inputs and the screens' game state.
+ */
+static void setup(void)
+{
+    srand(1);
+    for (int i = 0; i < INPUTS; i++)
+    {
+        pointX[i] = randomRange(0, SCREEN_WIDTH - 1);
+        pointY[i] = randomRange(0, SCREEN_HEIGHT - 1);
+        lineX1[i] = randomRange(0, SCREEN_WIDTH - 1);
+        lineY1[i] = randomRange(0, SCREEN_HEIGHT - 1);
+        lineX2[i] = randomRange(0, SCREEN_WIDTH - 1);
+        lineY2[i] = randomRange(0, SCREEN_HEIGHT - 1);
+        clipX1[i] = randomRange(-SCREEN_WIDTH / 2, SCREEN_WIDTH * 3 / 2);
+        clipY1[i] = randomRange(-SCREEN_HEIGHT / 2, SCREEN_HEIGHT * 3 / 2);
+        clipX2[i] = randomRange(-SCREEN_WIDTH / 2, SCREEN_WIDTH * 3 / 2);
+        clipY2[i] = randomRange(-SCREEN_HEIGHT / 2, SCREEN_HEIGHT * 3 / 2);
+    }
+
+    loadLogo();
+
+    hostFlashInit();
+    initI2C();
+    initDisplay();
+    initStars();
+    initAsteroidSprites();
+
+    // Gameplay: every asteroid on screen, every bullet in flight
+    initAsteroids();
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    {
+        asteroidPoolSpawn(&asteroids.pool);
+        asteroids.x[i] = 16 + (i * 37) % (SCREEN_WIDTH - 24);
+        asteroids.y[i] = 12 + (i * 23) % (SCREEN_HEIGHT - 24);
+    }
+    initBullets();
+    for (int i = 0; i < MAX_BULLETS; i++)
+    {
+        bulletPoolSpawn(&bullets.pool);
+        bullets.x[i] = 40 + i * 24;
+        bullets.y[i] = 20 + i * 8;
+    }
+    initPlayer(&player);
+    player.box.x = 24;
+    player.box.y = SCREEN_HEIGHT / 2;
+    lives = 3;
+    score = 12300;
+    highScore = 45000;
+    newHighScore = true;
+    captureGameFrame(&gameFrame);
+    gameFrame.transitionProgress = 0;
+    gameFrame.playerVisible = true;
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+        asteroids.x[i]--;
+    moveStars(FX_ONE);
+    captureGameFrame(&nextGameFrame);
+    nextGameFrame.transitionProgress = 0;
+    nextGameFrame.playerVisible = true;
+}
+
+/**
+ * @brief Prints the worst error of fxSin and fxCos against libm.
+ */
+static void checkFixedAccuracy(void)
+{
+    double worst = 0;
+    for (fixed_t x = FX_FROM_INT(-1500); x < FX_FROM_INT(1500); x += 977)
+    {
+        double radians = x / 65536.0;
+        double errorSin = fabs(fxSin(x) / 65536.0 - sin(radians));
+        double errorCos = fabs(fxCos(x) / 65536.0 - cos(radians));
+        worst = fmax(worst, fmax(errorSin, errorCos));
+    }
+    printf("fxSin/fxCos worst error against libm over [-1500, 1500] rad: %.2e\n\n", worst);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = argc > 1 ? argv[1] : NULL;
+
+    setup();
+    printf("\n");
+    checkFixedAccuracy();
+
+    benchRun(benchmarks, sizeof(benchmarks) / sizeof(benchmarks[0]), filter);
+    return 0;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file adc.h
+ * @brief Host stand-in for the Pico SDK "hardware/adc.h".
+ *
+ * Every input reads as the value set with hostAdcSet, mid-scale (a
+ * centered analog stick) by default.
+ */
+
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint16_t adc_read(void);
+
+/**
+ * @brief Sets the value an ADC input reads.
+ * @param input ADC input (0 to 3).
+ * @param value 12-bit sample.
+ */
+void hostAdcSet(uint input, uint16_t value);
+
+#endif // HOST_HARDWARE_ADC_H
@@ -0,0 +1,30 @@
+/**
+ * @file flash.h
+ * @brief Host stand-in for the Pico SDK "hardware/flash.h".
+ *
+ * The flash is an array in RAM mapped at XIP_BASE, with NOR semantics:
+ * erasing sets bytes to 0xFF and programming can only clear bits.
+ */
+
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE (1u << 16)
+
+/** @brief Size of the emulated flash (the Pico W has 2 MiB). */
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+
+/** @brief Emulated flash contents. */
+extern uint8_t hostFlash[PICO_FLASH_SIZE_BYTES];
+
+/** @brief Address the flash is read from, like the XIP window on the device. */
+#define XIP_BASE ((uintptr_t)hostFlash)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif // HOST_HARDWARE_FLASH_H
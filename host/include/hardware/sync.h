@@ -0,0 +1,20 @@
+/**
+ * @file sync.h
+ * @brief Host stand-in for the Pico SDK "hardware/sync.h".
+ */
+
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+#include <sched.h>
+
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) {}
+
+// Events between cores: the waiting thread just yields until there is work
+static inline void __sev(void) {}
+static inline void __wfe(void) { sched_yield(); }
+
+#endif // HOST_HARDWARE_SYNC_H
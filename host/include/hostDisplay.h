@@ -0,0 +1,65 @@
+/**
+ * @file hostDisplay.h
+ * @brief Headless SSD1306 for the host build.
+ *
+ * Emulates the display controller behind the I2C stand-in: commands set
+ * the addressing window and modes, data bytes land in an emulated GDDRAM.
+ * Every presented frame can be written out as a PBM image.
+ */
+
+#ifndef HOST_DISPLAY_H
+#define HOST_DISPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Width of the emulated panel in pixels. */
+#define HOST_DISPLAY_WIDTH 128
+/** @brief Height of the emulated panel in pixels. */
+#define HOST_DISPLAY_HEIGHT 64
+
+/** @brief Function run after every presented frame. */
+typedef void (*HostFrameHook)(uint32_t frame);
+
+/**
+ * @brief Handles one I2C write transaction addressed to the display.
+ * @param data Control byte followed by commands or data.
+ * @param len Bytes in the transaction.
+ */
+void hostDisplayWrite(const uint8_t *data, size_t len);
+
+/**
+ * @brief Marks the end of a frame: captures the panel and runs the hook.
+ *
+ * Called by showDisplay() after the flush.
+ */
+void hostDisplayPresent(void);
+
+/**
+ * @brief Writes every presented frame to a directory as frame_NNNNN.pbm.
+ * @param directory Existing directory, or NULL to stop writing.
+ */
+void hostDisplaySetDumpDirectory(const char *directory);
+
+/**
+ * @brief Sets the function run after every presented frame.
+ * @param hook Function, or NULL.
+ */
+void hostDisplaySetFrameHook(HostFrameHook hook);
+
+/**
+ * @brief Gets whether a pixel of the panel is lit, inversion applied.
+ * @param x Column.
+ * @param y Row.
+ * @return true if the pixel is lit.
+ */
+bool hostDisplayPixel(int x, int y);
+
+/**
+ * @brief Gets the number of frames presented so far.
+ * @return Frames presented.
+ */
+uint32_t hostDisplayFrames(void);
+
+#endif // HOST_DISPLAY_H
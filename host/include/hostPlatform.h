@@ -0,0 +1,84 @@
+/**
+ * @file hostPlatform.h
+ * @brief Controls of the host stand-ins for the RP2040 hardware.
+ *
+ * These have no counterpart in the SDK: the host main uses them to drive
+ * the simulated board (time, buttons and flash).
+ */
+
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @brief Makes sleeps return immediately, advancing a virtual clock instead.
+ *
+ * The game still sees time pass as on the board, so the frame scheduler
+ * and every timer behave the same, but frames run as fast as the host can.
+ *
+ * @param uncapped true to stop sleeping.
+ */
+void hostTimerSetUncapped(bool uncapped);
+
+/**
+ * @brief Sets the level a GPIO reads (true, pulled up, by default).
+ * @param gpio GPIO number.
+ * @param level Level read by gpio_get.
+ */
+void hostGpioSetLevel(uint gpio, bool level);
+
+/**
+ * @brief Presses a button wired to ground.
+ *
+ * Runs the GPIO interrupt callback for the falling edge, if enabled, like
+ * the interrupt handler would on the board.
+ *
+ * @param gpio GPIO of the button.
+ */
+void hostGpioPress(uint gpio);
+
+/**
+ * @brief Releases a button pressed with hostGpioPress.
+ *
+ * Runs the GPIO interrupt callback for the rising edge, if enabled.
+ *
+ * @param gpio GPIO of the button.
+ */
+void hostGpioRelease(uint gpio);
+
+/**
+ * @brief Erases the whole emulated flash, as on a new board.
+ */
+void hostFlashInit(void);
+
+/** @brief Exit status of a run ended by an injected power cut. */
+#define HOST_FLASH_POWER_CUT_STATUS 3
+
+/** @brief Power cut byte count meaning halfway through the operation. */
+#define HOST_FLASH_CUT_HALFWAY SIZE_MAX
+
+/**
+ * @brief Backs the emulated flash with a file.
+ *
+ * Loads the file, or creates it erased, and writes every later erase and
+ * program through to it.
+ *
+ * @param path File holding the flash image.
+ * @return false if the file can't be opened or created.
+ */
+bool hostFlashOpen(const char *path);
+
+/**
+ * @brief Cuts the power during a later flash operation.
+ *
+ * That erase or program only changes its first bytes, which reach the
+ * backing file, and the program exits with HOST_FLASH_POWER_CUT_STATUS.
+ *
+ * @param operations Operations from now, counting the one cut (1 for the next).
+ * @param bytes Bytes the operation changes before the power goes, at most
+ *              all of them; HOST_FLASH_CUT_HALFWAY for half.
+ */
+void hostFlashCutPowerAfter(uint32_t operations, size_t bytes);
+
+#endif // HOST_PLATFORM_H
@@ -0,0 +1,14 @@
+/**
+ * @file binary_info.h
+ * @brief Host stand-in for the Pico SDK "pico/binary_info.h".
+ *
+ * Binary info only describes device images, so declarations are dropped.
+ */
+
+#ifndef HOST_PICO_BINARY_INFO_H
+#define HOST_PICO_BINARY_INFO_H
+
+#define bi_decl(...)
+#define bi_decl_if_func_used(...)
+
+#endif // HOST_PICO_BINARY_INFO_H
@@ -0,0 +1,21 @@
+/**
+ * @file multicore.h
+ * @brief Host stand-in for the Pico SDK "pico/multicore.h".
+ *
+ * Core1 runs on a pthread (see hostMulticore.c). It never registers as a
+ * lockout victim, so lockouts are no-ops.
+ */
+
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+void multicore_launch_core1(void (*entry)(void));
+
+static inline bool multicore_lockout_victim_is_initialized(uint core_num) { return false; }
+static inline void multicore_lockout_victim_init(void) {}
+static inline void multicore_lockout_start_blocking(void) {}
+static inline void multicore_lockout_end_blocking(void) {}
+
+#endif // HOST_PICO_MULTICORE_H
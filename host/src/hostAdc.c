@@ -0,0 +1,40 @@
+/**
+ * @file hostAdc.c
+ * @brief Host implementation of the SDK ADC functions.
+ */
+
+#include "hardware/adc.h"
+
+/** @brief Number of ADC inputs. */
+#define HOST_ADC_INPUTS 4
+
+/** @brief Value of each input, mid-scale by default. */
+static uint16_t values[HOST_ADC_INPUTS] = {2048, 2048, 2048, 2048};
+/** @brief Input selected by adc_select_input. */
+static uint selectedInput = 0;
+
+void adc_init(void)
+{
+}
+
+void adc_gpio_init(uint gpio)
+{
+}
+
+void adc_select_input(uint input)
+{
+    selectedInput = input < HOST_ADC_INPUTS ? input : 0;
+}
+
+uint16_t adc_read(void)
+{
+    return values[selectedInput];
+}
+
+void hostAdcSet(uint input, uint16_t value)
+{
+    if (input < HOST_ADC_INPUTS)
+    {
+        values[input] = value & 0x0FFF;
+    }
+}
@@ -0,0 +1,247 @@
+/**
+ * @file hostDisplay.c
+ * @brief Implementation of the headless SSD1306.
+ *
+ * Only horizontal addressing is emulated, which is what the driver sets
+ * up. The segment remap and COM scan direction the driver selects are the
+ * ones that show the buffer unflipped, so they are not emulated either.
+ */
+
+#include "hostDisplay.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/** @brief Pages of the emulated panel. */
+#define HOST_DISPLAY_PAGES (HOST_DISPLAY_HEIGHT / 8)
+
+/** @brief Emulated display RAM, one byte per column per page. */
+static uint8_t gddram[HOST_DISPLAY_PAGES][HOST_DISPLAY_WIDTH];
+
+/** @brief Column window set with 0x21. */
+static uint8_t columnStart = 0, columnEnd = HOST_DISPLAY_WIDTH - 1;
+/** @brief Page window set with 0x22. */
+static uint8_t pageStart = 0, pageEnd = HOST_DISPLAY_PAGES - 1;
+/** @brief Position of the next data byte. */
+static uint8_t column = 0, page = 0;
+/** @brief Inverted (0xA7) or normal (0xA6) display. */
+static bool inverted = false;
+/** @brief Display on (0xAF) or off (0xAE). */
+static bool displayOn = false;
+
+/** @brief Command waiting for its arguments. */
+static uint8_t pendingCommand = 0;
+/** @brief Arguments still expected by the pending command. */
+static int pendingArguments = 0;
+/** @brief Arguments received for the pending command. */
+static uint8_t arguments[6];
+/** @brief Amount of arguments received. */
+static int argumentCount = 0;
+
+/** @brief Frames presented. */
+static uint32_t frames = 0;
+/** @brief Directory frames are written to, NULL when not dumping. */
+static const char *dumpDirectory = NULL;
+/** @brief Function run after every frame. */
+static HostFrameHook frameHook = NULL;
+
+/**
+ * @brief Gets how many argument bytes follow a command.
+ * @param command Command byte.
+ * @return Arguments of the command.
+ */
+static int commandArguments(uint8_t command)
+{
+    switch (command)
+    {
+    case 0x20: // memory addressing mode
+    case 0x81: // contrast
+    case 0x8D: // charge pump
+    case 0xA8: // multiplex ratio
+    case 0xD3: // display offset
+    case 0xD5: // clock divide
+    case 0xD9: // precharge
+    case 0xDA: // COM pins
+    case 0xDB: // VCOMH deselect
+        return 1;
+    case 0x21: // column address
+    case 0x22: // page address
+    case 0xA3: // vertical scroll area
+        return 2;
+    case 0x29: // vertical and horizontal scroll
+    case 0x2A:
+        return 5;
+    case 0x26: // horizontal scroll
+    case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Applies a command once all its arguments arrived.
+ * @param command Command byte.
+ */
+static void runCommand(uint8_t command)
+{
+    switch (command)
+    {
+    case 0x21:
+        columnStart = arguments[0] % HOST_DISPLAY_WIDTH;
+        columnEnd = arguments[1] % HOST_DISPLAY_WIDTH;
+        column = columnStart;
+        break;
+    case 0x22:
+        pageStart = arguments[0] % HOST_DISPLAY_PAGES;
+        pageEnd = arguments[1] % HOST_DISPLAY_PAGES;
+        page = pageStart;
+        break;
+    case 0xA6:
+    case 0xA7:
+        inverted = command & 1;
+        break;
+    case 0xAE:
+    case 0xAF:
+        displayOn = command & 1;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Feeds one command byte (or argument) to the controller.
+ * @param byte Byte received.
+ */
+static void commandByte(uint8_t byte)
+{
+    if (pendingArguments > 0)
+    {
+        arguments[argumentCount++] = byte;
+        if (--pendingArguments == 0)
+        {
+            runCommand(pendingCommand);
+        }
+        return;
+    }
+
+    pendingCommand = byte;
+    pendingArguments = commandArguments(byte);
+    argumentCount = 0;
+    if (pendingArguments == 0)
+    {
+        runCommand(byte);
+    }
+}
+
+/**
+ * @brief Stores one data byte and advances the address.
+ * @param byte Byte received.
+ */
+static void dataByte(uint8_t byte)
+{
+    gddram[page][column] = byte;
+    if (column++ >= columnEnd)
+    {
+        column = columnStart;
+        if (page++ >= pageEnd)
+        {
+            page = pageStart;
+        }
+    }
+}
+
+void hostDisplayWrite(const uint8_t *data, size_t len)
+{
+    if (len == 0)
+    {
+        return;
+    }
+
+    // Control byte: D/C# selects data (0x40) or commands (0x00)
+    bool isData = data[0] & 0x40;
+    for (size_t i = 1; i < len; i++)
+    {
+        if (isData)
+        {
+            dataByte(data[i]);
+        }
+        else
+        {
+            commandByte(data[i]);
+        }
+    }
+}
+
+bool hostDisplayPixel(int x, int y)
+{
+    if (!displayOn || x < 0 || x >= HOST_DISPLAY_WIDTH || y < 0 || y >= HOST_DISPLAY_HEIGHT)
+    {
+        return false;
+    }
+    bool lit = (gddram[y / 8][x] >> (y % 8)) & 1;
+    return lit != inverted;
+}
+
+/**
+ * @brief Writes the panel as a binary PBM, lit pixels white.
+ * @param path File to write.
+ */
+static void writePbm(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        printf("[hostDisplay] cannot write %s\n", path);
+        return;
+    }
+
+    fprintf(file, "P4\n%d %d\n", HOST_DISPLAY_WIDTH, HOST_DISPLAY_HEIGHT);
+    for (int y = 0; y < HOST_DISPLAY_HEIGHT; y++)
+    {
+        uint8_t row[HOST_DISPLAY_WIDTH / 8];
+        memset(row, 0, sizeof(row));
+        for (int x = 0; x < HOST_DISPLAY_WIDTH; x++)
+        {
+            // PBM 1 is black
+            if (!hostDisplayPixel(x, y))
+            {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+    fclose(file);
+}
+
+void hostDisplayPresent(void)
+{
+    if (dumpDirectory)
+    {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/frame_%05lu.pbm", dumpDirectory, (unsigned long)frames);
+        writePbm(path);
+    }
+
+    frames++;
+    if (frameHook)
+    {
+        frameHook(frames);
+    }
+}
+
+void hostDisplaySetDumpDirectory(const char *directory)
+{
+    dumpDirectory = directory;
+}
+
+void hostDisplaySetFrameHook(HostFrameHook hook)
+{
+    frameHook = hook;
+}
+
+uint32_t hostDisplayFrames(void)
+{
+    return frames;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file hostFlash.c
+ * @brief Host implementation of the SDK flash functions.
+ *
+ * The flash can be backed by a file, which then persists across runs like
+ * the board's flash across power cycles: it is read when opened and every
+ * erase or program is written through. A power cut can be injected into a
+ * later operation: that operation only changes its first bytes (half of
+ * them by default) and the program exits, as the board would lose power
+ * mid-write.
+ */
+
+#include "hardware/flash.h"
+#include "hostPlatform.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+uint8_t hostFlash[PICO_FLASH_SIZE_BYTES];
+
+/** @brief File backing the flash, or NULL. */
+static FILE *backing = NULL;
+/** @brief Operations until the power cut, 0 for none. */
+static uint32_t operationsUntilCut = 0;
+/** @brief Bytes the cut operation changes, or HOST_FLASH_CUT_HALFWAY. */
+static size_t cutBytes = HOST_FLASH_CUT_HALFWAY;
+
+void hostFlashInit(void)
+{
+    memset(hostFlash, 0xFF, sizeof(hostFlash));
+}
+
+bool hostFlashOpen(const char *path)
+{
+    hostFlashInit();
+    if (backing)
+        fclose(backing);
+
+    backing = fopen(path, "r+b");
+    if (backing)
+    {
+        // A shorter file (or an empty one) is erased past its end
+        size_t read = fread(hostFlash, 1, sizeof(hostFlash), backing);
+        if (read == sizeof(hostFlash))
+            return true;
+        fseek(backing, read, SEEK_SET);
+        return fwrite(hostFlash + read, 1, sizeof(hostFlash) - read, backing) == sizeof(hostFlash) - read &&
+               fflush(backing) == 0;
+    }
+
+    backing = fopen(path, "w+b");
+    if (!backing)
+        return false;
+    return fwrite(hostFlash, 1, sizeof(hostFlash), backing) == sizeof(hostFlash) && fflush(backing) == 0;
+}
+
+void hostFlashCutPowerAfter(uint32_t operations, size_t bytes)
+{
+    operationsUntilCut = operations;
+    cutBytes = bytes;
+}
+
+/**
+ * @brief Writes a range of the flash through to the backing file.
+ */
+static void writeThrough(uint32_t offset, size_t count)
+{
+    if (!backing)
+        return;
+    fseek(backing, offset, SEEK_SET);
+    fwrite(hostFlash + offset, 1, count, backing);
+    fflush(backing);
+}
+
+/**
+ * @brief Counts an operation towards the power cut.
+ * @param count Bytes the operation changes.
+ * @param cut Set to whether the power goes during this operation.
+ * @return Bytes it gets to change before the power goes.
+ */
+static size_t beginOperation(size_t count, bool *cut)
+{
+    *cut = operationsUntilCut != 0 && --operationsUntilCut == 0;
+    if (!*cut)
+        return count;
+    return cutBytes == HOST_FLASH_CUT_HALFWAY ? count / 2 : MIN(cutBytes, count);
+}
+
+/**
+ * @brief Ends an operation, and the program if the power was cut in it.
+ */
+static void endOperation(uint32_t offset, size_t count, size_t done, bool cut, const char *what)
+{
+    writeThrough(offset, count);
+    if (cut)
+    {
+        printf("[hostFlash] power cut during %s at 0x%lx (%zu of %zu bytes)\n", what, (unsigned long)offset, done,
+               count);
+        exit(HOST_FLASH_POWER_CUT_STATUS);
+    }
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES)
+    {
+        printf("[hostFlash] erase out of range or unaligned: 0x%lx+%zu\n", (unsigned long)flash_offs, count);
+        return;
+    }
+
+    bool cut;
+    size_t done = beginOperation(count, &cut);
+    memset(hostFlash + flash_offs, 0xFF, done);
+    endOperation(flash_offs, count, done, cut, "erase");
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES)
+    {
+        printf("[hostFlash] program out of range or unaligned: 0x%lx+%zu\n", (unsigned long)flash_offs, count);
+        return;
+    }
+
+    // NOR flash: programming can only clear bits
+    bool cut;
+    size_t done = beginOperation(count, &cut);
+    for (size_t i = 0; i < done; i++)
+    {
+        hostFlash[flash_offs + i] &= data[i];
+    }
+    endOperation(flash_offs, count, done, cut, "program");
+}
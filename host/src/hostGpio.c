@@ -0,0 +1,125 @@
+/**
+ * @file hostGpio.c
+ * @brief Host implementation of the SDK GPIO and stdio functions.
+ *
+ * Inputs read high, like the pulled-up buttons of the board at rest.
+ * Button presses are injected with hostGpioPress.
+ */
+
+#include "pico/stdlib.h"
+#include "hostPlatform.h"
+
+/** @brief Number of GPIOs of the RP2040. */
+#define HOST_GPIO_COUNT 30
+
+/** @brief Level of each GPIO. */
+static bool levels[HOST_GPIO_COUNT];
+/** @brief Whether the levels were initialized. */
+static bool levelsInitialized = false;
+/** @brief Interrupt events enabled on each GPIO. */
+static uint32_t irqEvents[HOST_GPIO_COUNT];
+/** @brief Shared GPIO interrupt callback. */
+static gpio_irq_callback_t irqCallback = NULL;
+
+/**
+ * @brief Puts every GPIO at the pulled-up level on first use.
+ */
+static void initLevels(void)
+{
+    if (levelsInitialized)
+    {
+        return;
+    }
+    for (int i = 0; i < HOST_GPIO_COUNT; i++)
+    {
+        levels[i] = true;
+    }
+    levelsInitialized = true;
+}
+
+void gpio_init(uint gpio)
+{
+    initLevels();
+}
+
+void gpio_set_dir(uint gpio, bool out)
+{
+}
+
+void gpio_pull_up(uint gpio)
+{
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+}
+
+bool gpio_get(uint gpio)
+{
+    initLevels();
+    return gpio < HOST_GPIO_COUNT ? levels[gpio] : false;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback)
+{
+    if (gpio >= HOST_GPIO_COUNT)
+    {
+        return;
+    }
+    if (enabled)
+    {
+        irqEvents[gpio] |= event_mask;
+    }
+    else
+    {
+        irqEvents[gpio] &= ~event_mask;
+    }
+    irqCallback = callback;
+}
+
+void hostGpioSetLevel(uint gpio, bool level)
+{
+    initLevels();
+    if (gpio < HOST_GPIO_COUNT)
+    {
+        levels[gpio] = level;
+    }
+}
+
+void hostGpioPress(uint gpio)
+{
+    if (gpio >= HOST_GPIO_COUNT)
+    {
+        return;
+    }
+
+    hostGpioSetLevel(gpio, false);
+    if (irqCallback && (irqEvents[gpio] & GPIO_IRQ_EDGE_FALL))
+    {
+        irqCallback(gpio, GPIO_IRQ_EDGE_FALL);
+    }
+}
+
+void hostGpioRelease(uint gpio)
+{
+    if (gpio >= HOST_GPIO_COUNT)
+    {
+        return;
+    }
+
+    hostGpioSetLevel(gpio, true);
+    if (irqCallback && (irqEvents[gpio] & GPIO_IRQ_EDGE_RISE))
+    {
+        irqCallback(gpio, GPIO_IRQ_EDGE_RISE);
+    }
+}
+
+bool stdio_init_all(void)
+{
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+    return PICO_ERROR_TIMEOUT;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file hostI2c.c
+ * @brief Host implementation of the SDK I2C functions.
+ *
+ * The only device on the bus is the headless display.
+ */
+
+#include "hardware/i2c.h"
+#include "hostDisplay.h"
+
+/** @brief I2C address of the emulated SSD1306. */
+#define HOST_DISPLAY_ADDRESS 0x3C
+
+struct i2c_inst
+{
+    int index;
+};
+
+i2c_inst_t i2c0_inst = {0};
+i2c_inst_t i2c1_inst = {1};
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    if (addr != HOST_DISPLAY_ADDRESS)
+    {
+        return PICO_ERROR_GENERIC;
+    }
+    hostDisplayWrite(src, len);
+    return (int)len;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file hostMain.c
+ * @brief Entry point of the host (Linux) build.
+ *
+ * Sets up the simulated board from the command line and runs the game's
+ * own main(), compiled as patroGalaxyMain. The game never returns, so the
+ * run ends from the frame hook once the requested frames were presented.
+ *
+ * Usage: PatroGalaxyHost [--frames N] [--dump DIR] [--uncapped] [--autofire N]
+ *                        [--record FILE] [--replay FILE] [--flash FILE] [--power-cut N[:BYTES]]
+ *   --frames N     stop after N frames (default: run forever)
+ *   --dump DIR     write every frame to DIR/frame_NNNNN.pbm
+ *   --uncapped     do not sleep: run frames as fast as possible
+ *   --autofire N   press button B every N frames, releasing it in between
+ *                  (starts games and shoots)
+ *   --record FILE  record the input of every tick, written to FILE at the end
+ *   --replay FILE  replay a recorded input log, check it and stop at its end
+ *   --flash FILE   keep the flash in FILE across runs (default: erased in RAM)
+ *   --power-cut N[:BYTES]
+ *                  lose power during the Nth flash erase or program, after
+ *                  its first BYTES bytes (default: halfway through)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hostDisplay.h"
+#include "hostPlatform.h"
+#include "initialize.h"
+#include "frameScheduler.h"
+#include "input.h"
+#include "inputLog.h"
+
+int patroGalaxyMain(void);
+
+/** @brief Frames to run, 0 for no limit. */
+static uint32_t frameLimit = 0;
+/** @brief Frames between presses of button B, 0 to never press it. */
+static uint32_t autofirePeriod = 0;
+/** @brief Whether autofire is holding button B down. */
+static bool autofireHeld = false;
+/** @brief When autofire pressed button B. */
+static uint32_t autofirePressTime = 0;
+/** @brief File the recorded input log is written to, if any. */
+static const char *recordPath = NULL;
+/** @brief File backing the flash, if any. */
+static const char *flashPath = NULL;
+/** @brief Wall clock at start, in seconds. */
+static double startSeconds = 0;
+
+/**
+ * @brief Reads the wall clock (not the virtual game clock).
+ * @return Seconds since an arbitrary point.
+ */
+static double wallSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Prints the run's timings, saves the recording and exits.
+ * @param frame Frames presented.
+ * @param status Exit status.
+ */
+static void finish(uint32_t frame, int status)
+{
+    double elapsed = wallSeconds() - startSeconds;
+    printf("%lu frames in %.3f s (%.1f frames/s, %.1f us/frame)\n",
+           (unsigned long)frame, elapsed, frame / elapsed, elapsed * 1e6 / frame);
+    frameSchedulerPrintStats();
+
+    if (recordPath)
+    {
+        FILE *out = fopen(recordPath, "w");
+        if (!out)
+        {
+            perror(recordPath);
+            exit(1);
+        }
+        inputLogDump(out);
+        fclose(out);
+        printf("Recorded %lu ticks to %s\n", (unsigned long)inputLogResult()->ticks, recordPath);
+    }
+
+    fflush(stdout);
+    exit(status);
+}
+
+/**
+ * @brief Drives the input and ends the run, after every frame.
+ * @param frame Frames presented so far.
+ */
+static void onFrame(uint32_t frame)
+{
+    // Held past the debounce time, or the release would count as a bounce
+    if (autofireHeld && time_us_32() - autofirePressTime >= INPUT_DEBOUNCE_US)
+    {
+        hostGpioRelease(BTB);
+        autofireHeld = false;
+    }
+    else if (!autofireHeld && autofirePeriod && frame % autofirePeriod == 0)
+    {
+        hostGpioPress(BTB);
+        autofireHeld = true;
+        autofirePressTime = time_us_32();
+    }
+
+    if (!recordPath && inputLogMode() == INPUT_LOG_FINISHED)
+    {
+        const InputLogResult *result = inputLogResult();
+        printf("Replayed %lu ticks: ", (unsigned long)result->ticks);
+        if (result->mismatches)
+        {
+            printf("%lu mismatches, first at tick %lu\n", (unsigned long)result->mismatches,
+                   (unsigned long)result->firstMismatch);
+        }
+        else
+        {
+            printf("every tick matched\n");
+        }
+        finish(frame, result->mismatches ? 2 : 0);
+    }
+
+    if (frameLimit && frame >= frameLimit)
+    {
+        finish(frame, 0);
+    }
+}
+
+/**
+ * @brief Prints the usage.
+ * @param program Name of the executable.
+ */
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [--frames N] [--dump DIR] [--uncapped] [--autofire N] "
+                    "[--record FILE] [--replay FILE] [--flash FILE] [--power-cut N[:BYTES]]\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+        {
+            frameLimit = strtoul(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "--dump") && i + 1 < argc)
+        {
+            hostDisplaySetDumpDirectory(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--uncapped"))
+        {
+            hostTimerSetUncapped(true);
+        }
+        else if (!strcmp(argv[i], "--autofire") && i + 1 < argc)
+        {
+            autofirePeriod = strtoul(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "--record") && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+            inputLogStartRecording();
+        }
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc)
+        {
+            FILE *in = fopen(argv[++i], "r");
+            if (!in || !inputLogStartReplay(in))
+            {
+                fprintf(stderr, "No input log in %s\n", argv[i]);
+                return 1;
+            }
+            fclose(in);
+        }
+        else if (!strcmp(argv[i], "--flash") && i + 1 < argc)
+        {
+            flashPath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--power-cut") && i + 1 < argc)
+        {
+            char *bytes;
+            uint32_t operations = strtoul(argv[++i], &bytes, 10);
+            hostFlashCutPowerAfter(operations, *bytes == ':' ? strtoul(bytes + 1, NULL, 10) : HOST_FLASH_CUT_HALFWAY);
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!flashPath)
+    {
+        hostFlashInit();
+    }
+    else if (!hostFlashOpen(flashPath))
+    {
+        fprintf(stderr, "Can't open flash image %s\n", flashPath);
+        return 1;
+    }
+    hostDisplaySetFrameHook(onFrame);
+    startSeconds = wallSeconds();
+
+    return patroGalaxyMain();
+}
@@ -0,0 +1,38 @@
+/**
+ * @file hostMulticore.c
+ * @brief Host implementation of the SDK core launch.
+ *
+ * Core1 is a detached pthread. Each thread knows which core it stands in
+ * for, so get_core_num answers as on the board.
+ */
+
+#include "pico/multicore.h"
+
+#include <pthread.h>
+
+/** @brief Core the calling thread stands in for: 0 unless launched as core1. */
+static _Thread_local uint coreNum = 0;
+
+/**
+ * @brief Thread running core1's entry point.
+ * @param arg Entry point.
+ */
+static void *core1Thread(void *arg)
+{
+    void (*entry)(void) = (void (*)(void))arg;
+    coreNum = 1;
+    entry();
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entry)(void))
+{
+    pthread_t thread;
+    pthread_create(&thread, NULL, core1Thread, (void *)entry);
+    pthread_detach(thread);
+}
+
+uint get_core_num(void)
+{
+    return coreNum;
+}
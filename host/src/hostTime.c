@@ -0,0 +1,84 @@
+/**
+ * @file hostTime.c
+ * @brief Host implementation of the SDK time and sleep functions.
+ *
+ * Time is the monotonic clock since start plus a virtual offset. In
+ * uncapped mode sleeps add to the offset instead of blocking, so the game
+ * sees the time it asked to wait go by without waiting for it.
+ */
+
+#include "pico/stdlib.h"
+#include "hostPlatform.h"
+
+#include <time.h>
+
+/** @brief Monotonic clock at the first reading, in microseconds. */
+static uint64_t startUs = 0;
+/** @brief Time skipped by sleeps in uncapped mode. */
+static uint64_t virtualOffsetUs = 0;
+/** @brief Whether sleeps advance the virtual clock instead of blocking. */
+static bool uncappedMode = false;
+
+/**
+ * @brief Reads the host monotonic clock.
+ * @return Microseconds since an arbitrary point.
+ */
+static uint64_t monotonicUs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+void hostTimerSetUncapped(bool uncapped)
+{
+    uncappedMode = uncapped;
+}
+
+uint64_t time_us_64(void)
+{
+    uint64_t now = monotonicUs();
+    if (startUs == 0)
+    {
+        startUs = now;
+    }
+    return now - startUs + virtualOffsetUs;
+}
+
+uint32_t time_us_32(void)
+{
+    return (uint32_t)time_us_64();
+}
+
+absolute_time_t get_absolute_time(void)
+{
+    return time_us_64();
+}
+
+void sleep_us(uint64_t us)
+{
+    if (uncappedMode)
+    {
+        virtualOffsetUs += us;
+        return;
+    }
+
+    struct timespec wait = {.tv_sec = us / 1000000u, .tv_nsec = (us % 1000000u) * 1000u};
+    while (nanosleep(&wait, &wait) != 0)
+    {
+    }
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+void sleep_until(absolute_time_t target)
+{
+    uint64_t now = time_us_64();
+    if (target > now)
+    {
+        sleep_us(target - now);
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * @file lineTest.c
+ * @brief Checks ssd1306_draw_line pixel for pixel against a plain Bresenham.
+ *
+ * The reference walks every step of the line in 64-bit arithmetic and
+ * plots the steps that land on the panel, so it has no clipping to get
+ * wrong. Lines on the panel, crossing its edges and far off it are drawn
+ * both ways into cleared buffers, which must come out identical.
+ *
+ * Usage: PatroGalaxyLineTest
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ssd1306.h"
+
+/** @brief Panel size, as on the board. */
+#define WIDTH 128
+#define HEIGHT 64
+
+/** @brief Random lines per coordinate range near the panel. */
+#define RANDOM_LINES 20000
+/** @brief Random lines per coordinate range far off it (the reference walks every step). */
+#define FAR_LINES 500
+
+/** @brief Panel drawn by the driver. */
+static ssd1306_t driver;
+/** @brief Panel drawn by the reference. */
+static ssd1306_t reference;
+
+/**
+ * @brief Plain Bresenham: every step, plotting only those on the panel.
+ *
+ * Walks the major axis a from the first end; the minor axis b moves when
+ * the error term turns positive, starting at 2*db-da.
+ */
+static void referenceLine(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    int64_t dx = llabs((int64_t)x2 - x1), dy = llabs((int64_t)y2 - y1);
+    int64_t sx = x2 > x1 ? 1 : -1, sy = y2 > y1 ? 1 : -1;
+    bool xMajor = dx >= dy;
+    int64_t da = xMajor ? dx : dy, db = xMajor ? dy : dx;
+    int64_t x = x1, y = y1, err = 2 * db - da;
+
+    for (int64_t k = 0; k <= da; k++)
+    {
+        if (x >= 0 && x < p->width && y >= 0 && y < p->height)
+            ssd1306_draw_pixel(p, (uint32_t)x, (uint32_t)y);
+
+        if (err > 0)
+        {
+            if (xMajor)
+                y += sy;
+            else
+                x += sx;
+            err -= 2 * da;
+        }
+        err += 2 * db;
+        if (xMajor)
+            x += sx;
+        else
+            y += sy;
+    }
+}
+
+/**
+ * @brief Random integer in [min, max].
+ */
+static int32_t randomRange(int32_t min, int32_t max)
+{
+    return min + (int32_t)(((uint64_t)rand() * RAND_MAX + rand()) % ((uint64_t)max - min + 1));
+}
+
+/**
+ * @brief Draws a line both ways and compares the buffers.
+ * @return true if they match.
+ */
+static bool checkLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    ssd1306_clear(&driver);
+    ssd1306_clear(&reference);
+    ssd1306_draw_line(&driver, x1, y1, x2, y2);
+    referenceLine(&reference, x1, y1, x2, y2);
+    if (!memcmp(driver.buffer, reference.buffer, driver.bufsize))
+        return true;
+
+    printf("FAIL: line (%ld, %ld) - (%ld, %ld)\n", (long)x1, (long)y1, (long)x2, (long)y2);
+    return false;
+}
+
+/**
+ * @brief Checks random lines with both ends in a rectangle.
+ * @return Number of mismatches.
+ */
+static int checkRandomLines(const char *name, int lines, int32_t minX, int32_t maxX, int32_t minY, int32_t maxY)
+{
+    int failures = 0;
+    for (int i = 0; i < lines && failures < 10; i++)
+    {
+        failures += !checkLine(randomRange(minX, maxX), randomRange(minY, maxY),
+                               randomRange(minX, maxX), randomRange(minY, maxY));
+    }
+    printf("%-24s %s\n", name, failures ? "FAIL" : "ok");
+    return failures;
+}
+
+int main(void)
+{
+    if (!ssd1306_init(&driver, WIDTH, HEIGHT, 0x3C, i2c1) ||
+        !ssd1306_init(&reference, WIDTH, HEIGHT, 0x3C, i2c1))
+    {
+        printf("cannot initialize the panels\n");
+        return 1;
+    }
+
+    srand(1);
+    int failures = 0;
+
+    // Every line from the corners and edge midpoints, just past the panel too
+    static const int32_t xs[] = {-1, 0, 63, 127, 128}, ys[] = {-1, 0, 31, 63, 64};
+    int fixed = 0;
+    for (int a = 0; a < 25; a++)
+        for (int b = 0; b < 25; b++)
+            fixed += !checkLine(xs[a % 5], ys[a / 5], xs[b % 5], ys[b / 5]);
+    printf("%-24s %s\n", "edges", fixed ? "FAIL" : "ok");
+    failures += fixed;
+
+    failures += checkRandomLines("on the panel", RANDOM_LINES, 0, WIDTH - 1, 0, HEIGHT - 1);
+    failures += checkRandomLines("crossing the edges", RANDOM_LINES, -WIDTH, 2 * WIDTH, -HEIGHT, 2 * HEIGHT);
+    failures += checkRandomLines("far off the panel", FAR_LINES, -50000, 50000, -50000, 50000);
+
+    // Long lines crossing the panel, where the first visible step is far along
+    int far = 0;
+    for (int i = 0; i < FAR_LINES && far < 10; i++)
+    {
+        int32_t reach = randomRange(20000, 200000);
+        far += !checkLine(-reach, randomRange(-reach, reach), reach, randomRange(-reach, reach));
+        far += !checkLine(randomRange(-reach, reach), -reach, randomRange(-reach, reach), reach);
+    }
+    printf("%-24s %s\n", "long through the panel", far ? "FAIL" : "ok");
+    failures += far;
+
+    ssd1306_deinit(&driver);
+    ssd1306_deinit(&reference);
+    return failures ? 1 : 0;
+}
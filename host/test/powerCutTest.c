@@ -0,0 +1,183 @@
+/**
+ * @file powerCutTest.c
+ * @brief Cuts the power at every point of the save log and checks the recovery.
+ *
+ * Each case starts from an erased save ring backed by a file. A child
+ * process keeps saving records until the power goes during its Nth flash
+ * operation, after the first BYTES bytes of it, reporting every save that
+ * completed through a pipe. The parent then reloads the file like a board
+ * booting again and checks that:
+ * - the newest record is the last completed save, or the one being
+ *   written if the cut left it whole, and its payload is intact;
+ * - the log goes on: the next save is written and read back as newest.
+ *
+ * N sweeps past the first wrap of the ring, so cuts land in the programs
+ * and in the erases, and BYTES sweeps through the record's header, its
+ * payload and the erased rest of the page.
+ *
+ * Usage: PatroGalaxyPowerCutTest
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "saveSystem.h"
+#include "hostPlatform.h"
+
+/** @brief Payload of every record: the sequence, then a pattern derived from it. */
+#define PAYLOAD_SIZE 84
+
+/** @brief Flash operations swept: every save of the ring, its erases and the wrap. */
+#define OPERATIONS (SAVE_PAGES + SAVE_SECTORS + 8)
+
+/** @brief Bytes of the cut operation that land, swept for every operation. */
+static const size_t cutBytes[] = {
+    0, 1, 3, 4, 8, 12, 15, 16, 17, 40, PAYLOAD_SIZE, sizeof(SaveRecordHeader) + PAYLOAD_SIZE - 1,
+    sizeof(SaveRecordHeader) + PAYLOAD_SIZE, FLASH_PAGE_SIZE - 1, FLASH_SECTOR_SIZE / 2, HOST_FLASH_CUT_HALFWAY,
+};
+
+/** @brief File backing the flash. */
+static char flashPath[] = "/tmp/patroGalaxyPowerCutXXXXXX";
+/** @brief Where the results go: stdout is silenced, the save system prints on every save. */
+static FILE *results;
+
+/**
+ * @brief Fills a payload for a sequence.
+ */
+static void makePayload(uint32_t sequence, uint8_t *payload)
+{
+    memcpy(payload, &sequence, sizeof(sequence));
+    for (size_t i = sizeof(sequence); i < PAYLOAD_SIZE; i++)
+        payload[i] = (uint8_t)(sequence * 31 + i);
+}
+
+/**
+ * @brief Reloads the flash from its file and reads the newest record.
+ * @param sequence Set to the sequence of the newest record, 0 if none.
+ * @return false if the newest record doesn't hold its own payload.
+ */
+static bool recover(uint32_t *sequence)
+{
+    if (!hostFlashOpen(flashPath))
+        return false;
+    initSaveSystem();
+
+    uint8_t payload[PAYLOAD_SIZE], wanted[PAYLOAD_SIZE];
+    *sequence = saveSequence();
+    size_t size = loadProgress(payload, sizeof(payload));
+    if (*sequence == 0)
+        return size == 0;
+
+    makePayload(*sequence, wanted);
+    return size == PAYLOAD_SIZE && !memcmp(payload, wanted, PAYLOAD_SIZE);
+}
+
+/**
+ * @brief Saves until the power goes, reporting every completed save.
+ *
+ * Runs in the child process; it never returns.
+ */
+static void saveUntilCut(uint32_t operations, size_t bytes, int report)
+{
+    hostFlashCutPowerAfter(operations, bytes);
+    initSaveSystem();
+    for (;;)
+    {
+        uint8_t payload[PAYLOAD_SIZE];
+        uint32_t sequence = saveSequence() + 1;
+        makePayload(sequence, payload);
+        if (!saveProgress(payload, sizeof(payload)))
+            exit(1);
+        if (write(report, &sequence, sizeof(sequence)) != sizeof(sequence))
+            exit(1);
+    }
+}
+
+/**
+ * @brief Runs one case from an erased ring.
+ * @return true if the recovery checks pass.
+ */
+static bool runCase(uint32_t operations, size_t bytes)
+{
+    // Erase the ring, through the file
+    if (!hostFlashOpen(flashPath))
+        return false;
+    flash_range_erase(FLASH_TARGET_OFFSET, SAVE_SECTORS * FLASH_SECTOR_SIZE);
+
+    int report[2];
+    if (pipe(report) != 0)
+        return false;
+
+    fflush(results);
+    pid_t child = fork();
+    if (child == 0)
+    {
+        close(report[0]);
+        saveUntilCut(operations, bytes, report[1]);
+    }
+    close(report[1]);
+
+    uint32_t completed = 0, sequence;
+    while (read(report[0], &sequence, sizeof(sequence)) == sizeof(sequence))
+        completed = sequence;
+    close(report[0]);
+
+    int status;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != HOST_FLASH_POWER_CUT_STATUS)
+    {
+        fprintf(results, "FAIL: cut %lu:%zu: the saves ended without the power cut\n", (unsigned long)operations, bytes);
+        return false;
+    }
+
+    uint32_t recovered;
+    if (!recover(&recovered) || (recovered != completed && recovered != completed + 1))
+    {
+        fprintf(results, "FAIL: cut %lu:%zu: recovered record %lu after %lu completed saves\n", (unsigned long)operations,
+               bytes, (unsigned long)recovered, (unsigned long)completed);
+        return false;
+    }
+
+    uint8_t payload[PAYLOAD_SIZE];
+    makePayload(recovered + 1, payload);
+    uint32_t next;
+    if (!saveProgress(payload, sizeof(payload)) || !recover(&next) || next != recovered + 1)
+    {
+        fprintf(results, "FAIL: cut %lu:%zu: the log doesn't go on after record %lu\n", (unsigned long)operations, bytes,
+               (unsigned long)recovered);
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    int fd = mkstemp(flashPath);
+    if (fd < 0)
+    {
+        printf("cannot create the flash file\n");
+        return 1;
+    }
+    close(fd);
+
+    results = fdopen(dup(fileno(stdout)), "w");
+    if (!results || !freopen("/dev/null", "w", stdout))
+        return 1;
+
+    int failures = 0, cases = 0;
+    for (uint32_t operations = 1; operations <= OPERATIONS && failures < 10; operations++)
+    {
+        for (size_t i = 0; i < sizeof(cutBytes) / sizeof(cutBytes[0]) && failures < 10; i++)
+        {
+            failures += !runCase(operations, cutBytes[i]);
+            cases++;
+        }
+    }
+
+    unlink(flashPath);
+    fprintf(results, "%d power cuts: %s\n", cases, failures ? "FAIL" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file saveDataTest.c
+ * @brief Checks that saveDataLoad rejects blocks whose header lies.
+ *
+ * Each case writes a save record, intact as far as the log can tell, whose
+ * block header claims some size, then loads it like a board booting. A
+ * valid block must come back; a size that doesn't match the layout of its
+ * version must fall back to the defaults, without reading past the record.
+ *
+ * Usage: PatroGalaxySaveDataTest
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "saveData.h"
+#include "saveSystem.h"
+#include "hostPlatform.h"
+
+/** @brief High score of the blocks written, to tell them from the defaults. */
+#define SCORE 1234
+
+/**
+ * @brief Saves a block with a version 1 header claiming a size.
+ *
+ * The block's CRC covers what the claimed size covers, when that fits the
+ * record, so only the size is wrong.
+ *
+ * @param claimed Size field of the header.
+ * @param length Bytes of the record's payload.
+ */
+static bool saveBlock(uint16_t claimed, size_t length)
+{
+    uint8_t payload[SAVE_PAYLOAD_SIZE];
+    SaveData block;
+    memset(&block, 0, sizeof(block));
+    block.version = 1;
+    block.size = claimed;
+    block.leaderboard[0] = (LeaderboardEntry){.score = SCORE, .game = 1};
+    memset(payload, 0, sizeof(payload));
+    memcpy(payload, &block, sizeof(block));
+
+    size_t start = offsetof(SaveData, leaderboard);
+    if (claimed >= start && claimed <= length)
+        block.crc = saveCrc32(0, payload + start, claimed - start);
+    memcpy(payload + offsetof(SaveData, crc), &block.crc, sizeof(block.crc));
+    return saveProgress(payload, length);
+}
+
+/**
+ * @brief Saves a block and loads it back.
+ * @return true if the high score it carries was loaded.
+ */
+static bool loads(uint16_t claimed, size_t length)
+{
+    if (!saveBlock(claimed, length))
+    {
+        printf("FAIL: cannot save a block of %zu bytes\n", length);
+        return false;
+    }
+    saveDataLoad();
+    return saveDataHighScore() == SCORE;
+}
+
+int main(void)
+{
+    hostFlashInit();
+
+    // Silence the save system while the checks run
+    FILE *results = fdopen(dup(fileno(stdout)), "w");
+    if (!results || !freopen("/dev/null", "w", stdout))
+        return 1;
+
+    int failures = 0;
+    static const struct
+    {
+        uint16_t claimed;
+        size_t length;
+        bool valid;
+    } cases[] = {
+        {sizeof(SaveData), sizeof(SaveData), true},
+        {0, sizeof(SaveData), false},
+        {7, sizeof(SaveData), false},
+        {8, sizeof(SaveData), false},
+        {sizeof(SaveData) + 1, sizeof(SaveData), false},
+        {sizeof(SaveData) + 1, sizeof(SaveData) + 1, false},
+        {UINT16_MAX, SAVE_PAYLOAD_SIZE, false},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        bool loaded = loads(cases[i].claimed, cases[i].length);
+        if (loaded != cases[i].valid)
+        {
+            fprintf(results, "FAIL: size %u in %zu bytes was %s\n", cases[i].claimed, cases[i].length,
+                    loaded ? "loaded" : "rejected");
+            failures++;
+        }
+    }
+
+    fprintf(results, "%-24s %s\n", "block sizes", failures ? "FAIL" : "ok");
+    return failures ? 1 : 0;
+}
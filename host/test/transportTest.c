@@ -0,0 +1,245 @@
+/**
+ * @file transportTest.c
+ * @brief Checks ssd1306_show against an asynchronous transport.
+ *
+ * The mock transport behaves like the DMA one: submit encodes the batch
+ * into its own stream and returns with the batch still "in flight", busy
+ * stays true until the test lets the bus finish, and a submit while busy
+ * first waits for (finishes) the batch in flight. Finished batches go to
+ * the emulated SSD1306 of the host build, whose RAM is compared with the
+ * frame each batch was made from.
+ *
+ * Frames are drawn into the buffer while the previous one is in flight.
+ * Every frame must reach the panel whole: not torn by the drawing that
+ * followed it, not dropped, and never overwritten in the stream before
+ * busy cleared.
+ *
+ * Usage: PatroGalaxyTransportTest
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "hostDisplay.h"
+
+/** @brief Panel size, as on the board. */
+#define WIDTH HOST_DISPLAY_WIDTH
+#define HEIGHT HOST_DISPLAY_HEIGHT
+/** @brief Bytes of a frame buffer. */
+#define FRAME_BYTES (WIDTH * HEIGHT / 8)
+/** @brief Address of the display. */
+#define ADDRESS 0x3C
+
+/** @brief Random frames drawn in the stress run. */
+#define RANDOM_FRAMES 2000
+
+/**
+ * @brief State of the mock transport.
+ */
+typedef struct
+{
+    uint8_t stream[SSD1306_BATCH_MAX_BYTES(WIDTH, HEIGHT)]; /**< Batch in flight, transactions back to back. */
+    uint16_t lengths[2 * HEIGHT / 8 + 1];                   /**< Size of each transaction in flight. */
+    size_t count;                                           /**< Transactions in flight. */
+    bool inFlight;                                          /**< Whether the bus is still busy. */
+    uint32_t submits;                                       /**< Batches submitted. */
+    uint32_t waits;                                         /**< Submits that had to wait for the bus. */
+    uint32_t delivered;                                     /**< Batches that reached the panel. */
+} MockTransport;
+
+static MockTransport mock;
+static ssd1306_t display;
+static int failures = 0;
+
+/** @brief Frame each batch in flight was made from, checked once it lands. */
+static uint8_t expected[FRAME_BYTES];
+/** @brief Whether the batch in flight carries a frame (not just commands). */
+static bool expectingFrame = false;
+
+/**
+ * @brief Records a failed check.
+ */
+static void check(bool condition, const char *what)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * @brief Compares the emulated panel with a frame buffer.
+ * @return true if every pixel matches.
+ */
+static bool panelShows(const uint8_t *frame)
+{
+    for (int y = 0; y < HEIGHT; y++)
+        for (int x = 0; x < WIDTH; x++)
+            if (hostDisplayPixel(x, y) != ((frame[x + WIDTH * (y / 8)] >> (y % 8)) & 1))
+                return false;
+    return true;
+}
+
+/**
+ * @brief Lets the bus finish the batch in flight, into the emulated panel.
+ */
+static void finishBus(void)
+{
+    if (!mock.inFlight)
+        return;
+
+    const uint8_t *data = mock.stream;
+    for (size_t i = 0; i < mock.count; data += mock.lengths[i++])
+        hostDisplayWrite(data, mock.lengths[i]);
+    mock.inFlight = false;
+    mock.delivered++;
+
+    if (expectingFrame)
+        check(panelShows(expected), "frame reached the panel whole");
+    expectingFrame = false;
+}
+
+static void mockSubmit(void *ctx, uint8_t address, const ssd1306_transaction_t *transactions, size_t count)
+{
+    check(ctx == &mock, "submit gets its context");
+    check(address == ADDRESS, "submit gets the display address");
+
+    // Like the DMA transport, the stream is only reused once the bus is free
+    if (mock.inFlight)
+    {
+        mock.waits++;
+        finishBus();
+    }
+
+    uint8_t *out = mock.stream;
+    for (size_t i = 0; i < count; i++)
+    {
+        *out++ = transactions[i].control;
+        memcpy(out, transactions[i].data, transactions[i].len);
+        out += transactions[i].len;
+        mock.lengths[i] = transactions[i].len + 1;
+    }
+    mock.count = count;
+    mock.inFlight = true;
+    mock.submits++;
+}
+
+static bool mockBusy(void *ctx)
+{
+    return ((MockTransport *)ctx)->inFlight;
+}
+
+/**
+ * @brief Flushes the buffer, remembering it as the frame the batch must show.
+ */
+static void show(void)
+{
+    uint32_t submits = mock.submits;
+    uint8_t frame[FRAME_BYTES];
+    memcpy(frame, display.buffer, FRAME_BYTES);
+
+    ssd1306_show(&display);
+
+    // An unchanged frame sends nothing; the panel already shows it
+    if (mock.submits != submits)
+    {
+        memcpy(expected, frame, FRAME_BYTES);
+        expectingFrame = true;
+    }
+}
+
+/**
+ * @brief Random integer in [min, max].
+ */
+static int32_t randomRange(int32_t min, int32_t max)
+{
+    return min + rand() % (max - min + 1);
+}
+
+/**
+ * @brief Draws a few random shapes, some of them off the panel.
+ */
+static void drawRandom(void)
+{
+    int shapes = randomRange(0, 4);
+    for (int i = 0; i < shapes; i++)
+    {
+        int32_t x = randomRange(-16, WIDTH + 16), y = randomRange(-16, HEIGHT + 16);
+        switch (rand() % 4)
+        {
+        case 0:
+            ssd1306_draw_line(&display, x, y, randomRange(-16, WIDTH + 16), randomRange(-16, HEIGHT + 16));
+            break;
+        case 1:
+            ssd1306_fill_rect(&display, x, y, randomRange(1, 40), randomRange(1, 20), SSD1306_FILL_SET);
+            break;
+        case 2:
+            ssd1306_fill_rect(&display, x, y, randomRange(1, 40), randomRange(1, 20), SSD1306_FILL_CLEAR);
+            break;
+        default:
+            ssd1306_draw_pixel(&display, (uint32_t)x, (uint32_t)y);
+            break;
+        }
+    }
+}
+
+int main(void)
+{
+    display.transport = (ssd1306_transport_t){.submit = mockSubmit, .busy = mockBusy, .ctx = &mock};
+    if (!ssd1306_init(&display, WIDTH, HEIGHT, ADDRESS, NULL))
+    {
+        printf("cannot initialize the display\n");
+        return 1;
+    }
+    check(ssd1306_busy(&display), "the init commands are in flight");
+    finishBus();
+    check(!ssd1306_busy(&display), "busy clears once the bus finished");
+
+    // A frame drawn while the previous one is in flight
+    ssd1306_clear(&display);
+    ssd1306_fill_rect(&display, 10, 10, 50, 30, SSD1306_FILL_SET);
+    show();
+    check(ssd1306_busy(&display), "frame A is in flight");
+    uint32_t waits = mock.waits;
+
+    ssd1306_fill_rect(&display, 0, 0, WIDTH, HEIGHT, SSD1306_FILL_INVERT);
+    check(mock.waits == waits && mock.inFlight, "drawing does not wait for the bus");
+
+    show();
+    check(mock.waits == waits + 1, "frame B waited for frame A to leave the stream");
+    check(mock.delivered == 2, "frame A reached the panel before frame B was encoded");
+
+    // The next flush diffs against frame B, so it must have been kept
+    ssd1306_clear_pixel(&display, 5, 5);
+    show();
+    check(mock.count == 2, "frame C is one window and one span");
+    finishBus();
+
+    // Nothing changed: nothing sent, nothing waited for
+    uint32_t submits = mock.submits;
+    ssd1306_show(&display);
+    check(mock.submits == submits, "an unchanged frame sends nothing");
+    printf("%-24s %s\n", "in flight", failures ? "FAIL" : "ok");
+
+    // Random frames, the bus finishing after a random number of them
+    int before = failures;
+    srand(1);
+    for (int i = 0; i < RANDOM_FRAMES; i++)
+    {
+        if (rand() % 8 == 0)
+            ssd1306_invalidate(&display);
+        drawRandom();
+        show();
+        if (rand() % 3 == 0)
+            finishBus();
+    }
+    finishBus();
+    check(panelShows(display.buffer), "the last frame stays on the panel");
+    printf("%-24s %s\n", "random frames", failures > before ? "FAIL" : "ok");
+
+    ssd1306_deinit(&display);
+    return failures ? 1 : 0;
+}
@@ -1,55 +0,0 @@
-const unsigned long ifpilogo_bmp_size=830;
-unsigned char ifpilogo_bmp_data[]={
-0x42,0x4d,0x3e,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x28,0x00,
-0x00,0x00,0x4a,0x00,0x00,0x00,0x40,0x00,0x00,0x00,0x01,0x00,0x01,0x00,0x00,0x00,
-0x00,0x00,0x00,0x03,0x00,0x00,0xc2,0x0e,0x00,0x00,0xc2,0x0e,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0x00,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xfb,0xd5,0x17,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xfb,0xd1,0x57,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xf8,0x55,0x57,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xfb,0x59,0x57,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xfc,0xff,0xfb,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xbc,0x30,0xe1,0x30,0xe8,0x3f,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xbc,0xf6,0x6f,0x24,0x09,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0x9c,0xf7,0x67,0x0e,0x09,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0x8c,0x37,0x61,0x06,
-0x59,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xbc,0xf7,0x67,0x26,0x19,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0x9c,0xf0,0x67,0x27,0x19,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0x84,0x30,0xe1,0x0f,0x3d,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xf6,0xe6,0x3d,0xde,0xf1,0xf7,0x87,0xff,0xc0,
-0x00,0x00,0xff,0xf6,0x66,0x1d,0xce,0xe0,0xf7,0x03,0xff,0xc0,0x00,0x00,0xff,0xf6,
-0x47,0x9d,0xce,0xe6,0x77,0x3b,0xff,0xc0,0x00,0x00,0xff,0xf6,0x57,0x1d,0xce,0xe6,
-0x77,0x7b,0xff,0xc0,0x00,0x00,0xff,0xf6,0x16,0x7d,0xce,0xe6,0x77,0x7b,0xff,0xc0,
-0x00,0x00,0xff,0xf6,0x36,0xfd,0xcc,0xe6,0x77,0x33,0xff,0xc0,0x00,0x00,0xff,0xf6,
-0x36,0x10,0x48,0x26,0x41,0x83,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xc0,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xc0,0xc0,0xc0,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xc0,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xc0,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xc0,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xc0,0xc0,0xc0,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc1,0xc0,0xff,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xe3,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0xc1,0xc0,0xc0,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0x80,0xc0,0xc0,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0x80,0xc0,0xc0,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0x80,0xc0,0xc0,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,
-0xff,0x80,0xc0,0xc0,0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xc1,0xc0,0xc0,
-0xff,0xff,0xff,0xc0,0x00,0x00,0xff,0xff,0xff,0xe3,0xff,0xff,0xff,0xff,0xff,0xc0,
-0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xc0,0x00,0x00
-};
@@ -0,0 +1,157 @@
+/**
+ * @file frameScheduler.c
+ * @brief Implementation for the frame scheduler module.
+ *
+ * Ticks are due every FRAME_PERIOD_US on an absolute timeline, so sleeping
+ * until the next deadline absorbs however long the frame took and errors
+ * never accumulate.
+ */
+
+#include "frameScheduler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+/** @brief Pacing statistics. */
+static FrameStats stats;
+/** @brief Time the next simulation tick is due. */
+static uint64_t nextTickUs = 0;
+/** @brief Start of the current frame, 0 right after a reset. */
+static uint64_t frameStartUs = 0;
+/** @brief Start of the current FPS measurement window. */
+static uint64_t fpsWindowStartUs = 0;
+/** @brief Frames started in the current FPS measurement window. */
+static uint32_t fpsWindowFrames = 0;
+
+void frameSchedulerInit()
+{
+    memset(&stats, 0, sizeof(stats));
+    frameSchedulerReset();
+}
+
+void frameSchedulerReset()
+{
+    uint64_t now = time_us_64();
+    nextTickUs = now;
+    frameStartUs = 0;
+    fpsWindowStartUs = now;
+    fpsWindowFrames = 0;
+}
+
+/**
+ * @brief Adds the duration of a complete frame to the statistics.
+ * @param frameUs Time between two frame starts.
+ */
+static void recordFrame(uint32_t frameUs)
+{
+    stats.lastFrameUs = frameUs;
+    if (frameUs > stats.maxFrameUs)
+    {
+        stats.maxFrameUs = frameUs;
+    }
+
+    uint32_t bucket = frameUs / FRAME_HISTOGRAM_BUCKET_US;
+    if (bucket >= FRAME_HISTOGRAM_BUCKETS)
+    {
+        bucket = FRAME_HISTOGRAM_BUCKETS - 1;
+    }
+    stats.histogram[bucket]++;
+}
+
+/**
+ * @brief Starts a frame.
+ * @param maxTicks Most ticks to hand out; the rest of a backlog is dropped.
+ * @return Simulation ticks to run in this frame (1 to maxTicks).
+ */
+static int beginFrame(int maxTicks)
+{
+    uint64_t now = time_us_64();
+
+    if (frameStartUs != 0)
+    {
+        recordFrame((uint32_t)(now - frameStartUs));
+    }
+    frameStartUs = now;
+    stats.frames++;
+
+    // Frames per second, measured over windows of one second
+    fpsWindowFrames++;
+    if (now - fpsWindowStartUs >= 1000000)
+    {
+        stats.fpsTenths = (uint32_t)(fpsWindowFrames * 10000000ull / (now - fpsWindowStartUs));
+        fpsWindowStartUs = now;
+        fpsWindowFrames = 0;
+    }
+
+    // Every tick whose time has come runs now
+    int ticks = 0;
+    while (now >= nextTickUs && ticks < maxTicks)
+    {
+        nextTickUs += FRAME_PERIOD_US;
+        ticks++;
+    }
+
+    // Too far behind: drop what is left and restart the timeline
+    if (now >= nextTickUs)
+    {
+        stats.droppedTicks += (uint32_t)((now - nextTickUs) / FRAME_PERIOD_US) + 1;
+        nextTickUs = now + FRAME_PERIOD_US;
+    }
+
+    // Called early (without frameSchedulerEnd): still advance one tick
+    if (ticks == 0)
+    {
+        nextTickUs += FRAME_PERIOD_US;
+        ticks = 1;
+    }
+
+    stats.ticks += ticks;
+    return ticks;
+}
+
+int frameSchedulerBegin()
+{
+    return beginFrame(FRAME_MAX_CATCH_UP);
+}
+
+void frameSchedulerBeginSingle()
+{
+    beginFrame(1);
+}
+
+void frameSchedulerEnd()
+{
+    if (time_us_64() >= nextTickUs)
+    {
+        stats.overruns++;
+        return;
+    }
+    sleep_until(from_us_since_boot(nextTickUs));
+}
+
+const FrameStats *frameSchedulerStats()
+{
+    return &stats;
+}
+
+void frameSchedulerPrintStats()
+{
+    printf("Quadros: %lu, ticks: %lu, %lu.%lu fps, estouros: %lu, ticks descartados: %lu, pior quadro: %lu us\n",
+           (unsigned long)stats.frames, (unsigned long)stats.ticks,
+           (unsigned long)(stats.fpsTenths / 10), (unsigned long)(stats.fpsTenths % 10),
+           (unsigned long)stats.overruns, (unsigned long)stats.droppedTicks,
+           (unsigned long)stats.maxFrameUs);
+
+    for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; i++)
+    {
+        if (stats.histogram[i] > 0)
+        {
+            printf("  %2d-%2d ms%s: %lu\n", i * FRAME_HISTOGRAM_BUCKET_US / 1000,
+                   (i + 1) * FRAME_HISTOGRAM_BUCKET_US / 1000,
+                   i == FRAME_HISTOGRAM_BUCKETS - 1 ? "+" : "",
+                   (unsigned long)stats.histogram[i]);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file frameScheduler.h
+ * @brief Header file for the frame scheduler module.
+ *
+ * Paces the state loops to a fixed frame period measured with the
+ * microsecond timer, instead of sleeping a fixed time after the work.
+ * The simulation runs in fixed ticks: when a frame runs late, the next one
+ * runs extra ticks to catch up, so game speed does not depend on how long
+ * drawing and the display transfer take.
+ */
+
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <stdint.h>
+
+/** @brief Target frame period (and simulation tick) in microseconds, 40 Hz. */
+#define FRAME_PERIOD_US 25000
+
+/** @brief Most ticks run in one frame; a longer stall drops the extra ticks. */
+#define FRAME_MAX_CATCH_UP 4
+
+/** @brief Amount of buckets of the frame-time histogram. */
+#define FRAME_HISTOGRAM_BUCKETS 16
+
+/** @brief Width of each histogram bucket in microseconds (the last one is open ended). */
+#define FRAME_HISTOGRAM_BUCKET_US 5000
+
+/**
+ * @brief Frame pacing statistics.
+ */
+typedef struct
+{
+    uint32_t frames;                                /**< Frames started since initialization. */
+    uint32_t ticks;                                 /**< Simulation ticks handed out. */
+    uint32_t overruns;                              /**< Frames whose work did not fit in the period. */
+    uint32_t droppedTicks;                          /**< Ticks skipped because catch up was capped or off. */
+    uint32_t fpsTenths;                             /**< Frames per second over the last second, times 10. */
+    uint32_t lastFrameUs;                           /**< Duration of the last complete frame. */
+    uint32_t maxFrameUs;                            /**< Longest frame seen. */
+    uint32_t histogram[FRAME_HISTOGRAM_BUCKETS];    /**< Frame durations, FRAME_HISTOGRAM_BUCKET_US per bucket. */
+} FrameStats;
+
+/**
+ * @brief Initializes the scheduler and clears the statistics.
+ */
+void frameSchedulerInit();
+
+/**
+ * @brief Restarts the tick clock from now.
+ *
+ * Call when entering a state loop, so time spent outside the loops is not
+ * caught up as simulation ticks.
+ */
+void frameSchedulerReset();
+
+/**
+ * @brief Starts a frame.
+ * @return Simulation ticks to run in this frame (1 to FRAME_MAX_CATCH_UP).
+ */
+int frameSchedulerBegin();
+
+/**
+ * @brief Starts a frame that runs exactly one tick.
+ *
+ * For the screens that update and draw in the same step (splash, title,
+ * game over): a late frame drops its backlog instead of catching it up.
+ */
+void frameSchedulerBeginSingle();
+
+/**
+ * @brief Ends a frame, sleeping for what is left of its period.
+ */
+void frameSchedulerEnd();
+
+/**
+ * @brief Gets the pacing statistics.
+ * @return Statistics since initialization.
+ */
+const FrameStats *frameSchedulerStats();
+
+/**
+ * @brief Prints the pacing statistics to stdio.
+ */
+void frameSchedulerPrintStats();
+
+#endif // FRAME_SCHEDULER_H
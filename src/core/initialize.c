@@ -11,7 +11,7 @@ typedef void (*callback_t)(uint gpio, uint32_t events);
  *
  * This function initializes two buttons (BTA and BTB) by setting up their GPIO pins,
  * configuring them as input, enabling pull-up resistors, and setting up an interrupt
- * on the rising edge with the provided callback function.
+ * on both edges with the provided callback function.
  *
  * @param handleButtonGPIOEvent The callback function to be called when a button is pressed.
  *                         If NULL, the function returns immediately without initializing the buttons.
@@ -26,7 +26,7 @@ void initButtons(callback_t handleButtonGPIOEvent)
         gpio_init(buttons[i]);
         gpio_set_dir(buttons[i], GPIO_IN);
         gpio_pull_up(buttons[i]);
-        gpio_set_irq_enabled_with_callback(buttons[i], GPIO_IRQ_EDGE_RISE, true, handleButtonGPIOEvent);
+        gpio_set_irq_enabled_with_callback(buttons[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, handleButtonGPIOEvent);
         printf("Botão %d inicializado\n", i);
     }
 }
\ No newline at end of file
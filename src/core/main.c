@@ -14,16 +14,18 @@
 #include <stdint.h>
 
 // General Imports
-#include <math.h>
 #include <string.h>
 #include <time.h>
 
 // Project Utils Imports
 #include "initialize.h"
 #include "utils.h"
-#include "saveSystem.h"
+#include "fixedMath.h"
+#include "saveManager.h"
+#include "saveData.h"
 #include "display.h"
 #include "analog.h"
+#include "input.h"
 #include "text.h"
 #include "draw.h"
 
@@ -32,6 +34,12 @@
 #include "background.h"
 #include "asteroids.h"
 #include "patroGalaxyUtils.h"
+#include "renderWorker.h"
+#include "main.h"
+#include "frameScheduler.h"
+#include "profiler.h"
+#include "inputLog.h"
+#include "random.h"
 
 // Pico SDK imports
 #include "pico/stdlib.h"
@@ -40,12 +48,8 @@
 // #include "hardware/timer.h"  // Deactivated for now.
 // #include "hardware/irq.h"    // Deactivated for now.
 
-// Images
-#include "ifpilogo.h"
-
-// Game Definitions
-/** @brief The time of every cicle */
-#define STEP_CYCLE 3
+// Images (generated at build time from src/assets/images)
+#include "ifpilogo_image.h"
 
 /**
  * @brief Enum to represent the game states.
@@ -70,9 +74,9 @@ int score = 0;
 /** @brief The value the the game will to draw (animated) */
 int scoreDraw = 0;
 /** @brief Game Speed, affects the game logic */
-float gameSpeed = 1.0;
+fixed_t gameSpeed = FX_ONE;
 /** @brief Hightscore in a previous game */
-uint16_t highScore = 0;
+uint32_t highScore = 0;
 /** @brief Flag for a new hightscore or not */
 bool newHighScore = false;
 /** @brief Time of the player spawn on the screen */
@@ -93,6 +97,10 @@ int transitionProgress = 100;
 int transitioningToState = -1;
 /** @brief Prevents the player of saving the record every time a value is hit*/
 bool gameSaved = false;
+/** @brief Asteroids shot down in this game, for the statistics */
+int asteroidsDestroyed = 0;
+/** @brief Simulation ticks of this game, for the statistics */
+uint32_t gameTicks = 0;
 
 /**
  * @brief Changes the game state.
@@ -109,15 +117,14 @@ void changeGameState(enum GAME_STATES state)
 }
 
 /**
- * @brief Callback function to handle GPIO events.
+ * @brief Acts on a button press.
  *
- * This function is called when a GPIO event occurs. It checks the current game state
- * and performs actions based on the GPIO pin that triggered the event.
+ * Checks the current game state and performs actions based on the button
+ * pressed. Runs at the start of a tick, never from the interrupt.
  *
- * @param gpio The GPIO pin number that triggered the event.
- * @param events The event mask indicating the type of event that occurred.
+ * @param gpio The GPIO pin of the button pressed.
  */
-void handleButtonGPIOEvent(uint gpio, uint32_t events)
+void handleButtonPress(uint gpio)
 {
     switch (gameState)
     {
@@ -154,32 +161,80 @@ void handleButtonGPIOEvent(uint gpio, uint32_t events)
 }
 
 /**
- * @brief Draws the user interface on the SSD1306 display.
+ * @brief Callback function to handle GPIO events.
  *
- * This function updates the display with the current interface elements, including the header, bottom bar, lives, and score.
- * The header alternates between displaying the IP address and a static text "EmbarcaTech" every 100 steps.
- * The bottom bar displays the current number of lives and the score.
+ * Runs in interrupt context, so it only queues the edges; the game acts on
+ * them at the start of the next tick (see processInput).
  *
- * @note The function assumes the existence of global variables: `display`, `headerMode`, `ip_str`, `steps`, `lives`, `score`, and `scoreDraw`.
- * @note The function uses the SSD1306 library functions to draw on the display.
+ * @param gpio The GPIO pin number that triggered the event.
+ * @param events The event mask indicating the type of event that occurred.
  */
-void drawInterface()
+void handleButtonGPIOEvent(uint gpio, uint32_t events)
 {
-    static int steps = 0;
+    inputHandleGPIOEvent(gpio, events);
+}
 
-    // Header
-    ssd1306_clear_square(&display, 0, 0, SCREEN_WIDTH, 9);
-    char headerText[50];
-    if (headerMode == 0)
+/**
+ * @brief Starts a tick: samples the input and acts on the buttons pressed.
+ */
+void processInput()
+{
+    PROFILE_BEGIN(PROFILE_STAGE_INPUT);
+    InputTick input = inputSample();
+    PROFILE_END(PROFILE_STAGE_INPUT);
+
+    if (input.pressed & INPUT_BUTTON_A)
     {
-        sprintf(headerText, "High Score: %d", highScore);
+        handleButtonPress(BTA);
     }
-    else
+    if (input.pressed & INPUT_BUTTON_B)
     {
-        sprintf(headerText, "EmbarcaTech");
+        handleButtonPress(BTB);
     }
-    drawText(0, 0, headerText);
-    ssd1306_draw_line(&display, 0, 9, SCREEN_WIDTH, 9);
+}
+
+/**
+ * @brief Hashes the simulation state, for the input log.
+ *
+ * Covers everything a tick changes that later ticks depend on. The high
+ * score is left out: it comes from flash, which is not part of a recording.
+ *
+ * @return Hash of the state.
+ */
+uint32_t hashGameState()
+{
+    int32_t values[] = {gameState, transitionProgress, transitioningToState, lives, score, scoreDraw,
+                        gameSpeed, playerSpawnTime, shootCooldown, playerInvulnerableTimer, flashScreen};
+
+    uint32_t hash = inputLogHash(INPUT_LOG_HASH_SEED, values, sizeof(values));
+    hash = inputLogHash(hash, &player, sizeof(player));
+    hash = inputLogHash(hash, &asteroids, sizeof(asteroids));
+    hash = inputLogHash(hash, &bullets, sizeof(bullets));
+    return inputLogHash(hash, stars, sizeof(stars));
+}
+
+/**
+ * @brief Ends a tick, reporting its state to the input log.
+ */
+void endTick()
+{
+    if (inputLogActive())
+    {
+        inputLogEndTick(hashGameState());
+    }
+}
+
+/**
+ * @brief Updates the user interface state.
+ *
+ * Animates the drawn score towards the real one and alternates the header
+ * between the high score and the level name every 100 steps.
+ *
+ * @note The function assumes the existence of global variables: `headerMode`, `highScore`, `score`, and `scoreDraw`.
+ */
+void updateInterface()
+{
+    static int steps = 0;
 
     steps++;
     if (steps % 100 == 0)
@@ -187,31 +242,57 @@ void drawInterface()
         headerMode = !headerMode;
     }
     // If there is no high score, do not show header 0.
-    if (highScore <= 0)
+    if (highScore == 0)
     {
         headerMode = 1;
     }
 
+    scoreDraw = scoreDraw < score ? scoreDraw + 10 : score;
+}
+
+/**
+ * @brief Draws the user interface on the SSD1306 display.
+ *
+ * This function updates the display with the current interface elements, including the header, bottom bar, lives, and score.
+ * The header shows either the high score or a static text "EmbarcaTech", depending on the header mode.
+ * The bottom bar displays the current number of lives and the score.
+ *
+ * @param frame Snapshot holding the values to show.
+ * @note The function uses the SSD1306 library functions to draw on the display.
+ */
+void drawInterface(const GameFrame *frame)
+{
+    // Header
+    ssd1306_clear_square(&display, 0, 0, SCREEN_WIDTH, 9);
+    char headerText[50];
+    if (frame->headerMode == 0)
+    {
+        sprintf(headerText, "High Score: %lu", (unsigned long)frame->highScore);
+    }
+    else
+    {
+        sprintf(headerText, "EmbarcaTech");
+    }
+    drawText(0, 0, headerText);
+    ssd1306_draw_line(&display, 0, 9, SCREEN_WIDTH, 9);
+
     // Draw Bottom Bar
     ssd1306_draw_line(&display, 0, SCREEN_HEIGHT - 11, SCREEN_WIDTH, SCREEN_HEIGHT - 11);
     ssd1306_clear_square(&display, 0, SCREEN_HEIGHT - 10, SCREEN_WIDTH, SCREEN_HEIGHT);
 
     // Draw Lives
     char text[50];
-    sprintf(text, "Lives: %d", lives);
+    sprintf(text, "Lives: %d", frame->lives);
     drawText(0, SCREEN_HEIGHT - 8, text);
 
     // Draw Score
-    scoreDraw = scoreDraw < score ? scoreDraw + 10 : score;
-    sprintf(text, "Score: %d", scoreDraw);
+    sprintf(text, "Score: %d", frame->scoreDraw);
     drawText(SCREEN_WIDTH / 2 - 1, SCREEN_HEIGHT - 8, text);
 }
 
 /**
- * @brief Draws a transition effect on the screen.
+ * @brief Updates the transition effect.
  *
- * This function handles the transition effect by updating the transition progress
- * and drawing a rectangle that covers the screen based on the current progress.
  * The transition progress is incremented or decremented based on whether the
  * transition is fading out or not. The progress is clamped between 0 and 100.
  * When the transition progress reaches 100 and a new state is specified, the
@@ -222,13 +303,8 @@ void drawInterface()
  *   A value of -1 indicates no transition.
  * - transitionProgress: An integer representing the current progress of the transition.
  * - gameState: An integer representing the current game state.
- * - SCREEN_HEIGHT: An integer representing the height of the screen.
- * - SCREEN_WIDTH: An integer representing the width of the screen.
- * - display: A display object used for drawing.
- *
- * The function uses the ssd1306_clear_square function to draw the transition effect.
  */
-void drawTransition()
+void updateTransition()
 {
     int fadingOut = (transitioningToState == -1);
     transitionProgress += 6 * (1 - (2 * (fadingOut)));
@@ -242,10 +318,23 @@ void drawTransition()
         gameState = transitioningToState;
         transitioningToState = -1;
     }
+}
 
+/**
+ * @brief Draws a transition effect on the screen.
+ *
+ * This function draws a rectangle that covers the screen based on the
+ * given transition progress.
+ *
+ * @param progress Progress of the transition, from 0 to 100.
+ *
+ * The function uses the ssd1306_clear_square function to draw the transition effect.
+ */
+void drawTransition(int progress)
+{
     // Draw a rectangle covering the screen based on the value of startProgress
-    int rectHeight = (SCREEN_HEIGHT * transitionProgress) / 100;
-    if (transitionProgress >= 100)
+    int rectHeight = (SCREEN_HEIGHT * progress) / 100;
+    if (progress >= 100)
     {
         rectHeight = SCREEN_HEIGHT;
     }
@@ -258,8 +347,8 @@ void drawTransition()
  * This function is called when the player dies. It decrements the player's lives,
  * sets the player to be invulnerable for a short period, and respawns the player
  * at a specific location. If the player has no remaining lives, it changes the game state
- * to the game over state and checks if the current score is a new high score. If a new high score
- * is achieved, it saves the high score.
+ * to the game over state, checks if the current score is a new high score and queues the
+ * game's score and statistics to be saved.
  *
  * @note This function assumes the existence of global variables such as `lives`, `playerInvulnerableTimer`,
  * `playerSpawnTime`, `player`, `flashScreen`, `score`, `highScore`, `newHighScore`, and `gameSaved`.
@@ -278,25 +367,254 @@ void playerDeath()
     {
         changeGameState(GAME_OVER);
 
-        // Check high score
-        if (score > highScore)
+        // Add the game to the leaderboard and statistics; it's written on
+        // the game over screen, not in the middle of this tick
+        if (!gameSaved)
         {
-            newHighScore = true;
-            highScore = score;
-            if (!gameSaved)
+            int place = saveDataRecordGame(score, asteroidsDestroyed, gameTicks);
+            saveDataFlush();
+            gameSaved = true;
+
+            // First place on the leaderboard is the new high score
+            if (place == 0)
             {
-                printf("New highscore: %d\n", highScore);
-                // Create a buffer to store the high score
-                uint8_t buffer[2];
-                createBuffer(highScore, buffer);
-                saveProgress(buffer);
-                gameSaved = true;
-                printf("Game saved: %d\n", gameSaved);
+                newHighScore = true;
+                highScore = score;
+                printf("New highscore: %lu\n", (unsigned long)highScore);
             }
         }
     }
 }
 
+/**
+ * @brief Runs one simulation step of the game state.
+ *
+ * Moves every entity, handles input, collisions, spawning and the interface
+ * and transition state. Does not draw anything.
+ */
+void updateGame()
+{
+    processInput();
+
+    // Increase game speed at each score interval
+    gameSpeed = FX_ONE + fxIntDiv(score, FX_FROM_INT(300) + 100 * gameSpeed);
+
+    if (playerSpawnTime > 0)
+    {
+        player.box.x = -40 + (30 - playerSpawnTime) * 2;
+        playerSpawnTime--;
+    }
+    // Background
+    moveStars(gameSpeed);
+
+    // Player
+    int canMove = (playerSpawnTime == 0);
+    if (canMove)
+    {
+        movePlayer(&player, analog_x, analog_y);
+    }
+
+    shootCooldown = shootCooldown > 0 ? shootCooldown - 1 : 0;
+    playerInvulnerableTimer = playerInvulnerableTimer > 0 ? playerInvulnerableTimer - 1 : 0;
+
+    if (playerInvulnerableTimer % 2 == 0)
+    {
+        updatePlayerParticles(&player);
+    }
+
+    // Asteroids
+    if (fxFromInt(getAsteroidsActive()) < MIN(FX_FROM_INT(3) + gameSpeed / 4, FX_FROM_INT(MAX_ASTEROIDS)))
+    {
+        spawnAsteroid();
+    }
+
+    // Update game entities
+    moveAsteroids(FX_ONE + gameSpeed / 4);
+    updateBullets();
+
+    // Collisions
+    CollisionPair pairs[MAX_COLLISION_PAIRS];
+    int collisions = findCollisions(&player, pairs);
+
+    if (checkPlayerCollision(&player, pairs, collisions))
+    {
+        playerDeath();
+    }
+    int kills = checkBulletsCollisions(pairs, collisions);
+    score += 100 * kills;
+    asteroidsDestroyed += kills;
+    gameTicks++;
+
+    updateInterface();
+    updateTransition();
+
+    // Flash Screen
+    flashScreen = flashScreen > 0 ? flashScreen - 1 : 0;
+
+    endTick();
+}
+
+/**
+ * @brief Copies the state needed to draw the game into a snapshot.
+ * @param frame Snapshot to fill.
+ */
+void captureGameFrame(GameFrame *frame)
+{
+    frame->asteroids = asteroids;
+    frame->bullets = bullets;
+    memcpy(frame->stars, stars, sizeof(stars));
+    frame->player = player;
+    frame->playerVisible = (playerInvulnerableTimer % 2 == 0);
+    frame->lives = lives;
+    frame->scoreDraw = scoreDraw;
+    frame->highScore = highScore;
+    frame->headerMode = headerMode;
+    frame->transitionProgress = transitionProgress;
+    frame->invert = flashScreen;
+}
+
+/**
+ * @brief Draws a gameplay frame from a snapshot into the display buffer.
+ *
+ * Only reads the snapshot, so it can run on core1 while core0 simulates.
+ *
+ * @param frame Snapshot to draw.
+ */
+void drawGameFrame(const GameFrame *frame)
+{
+    clearDisplay();
+
+    // Background
+    drawStars(frame->stars, MAX_STARS);
+
+    // Player
+    if (frame->playerVisible)
+    {
+        drawPlayer(&frame->player);
+    }
+
+    // Draw game entities
+    drawAsteroids(&frame->asteroids);
+    drawBullets(&frame->bullets);
+
+    // Draw Interface
+    drawInterface(frame);
+
+    // Draw Transition Above Everything
+    drawTransition(frame->transitionProgress);
+}
+
+/**
+ * @brief Draws a gameplay frame from a snapshot and sends it to the display.
+ *
+ * Only reads the snapshot, so it can run on core1 while core0 simulates.
+ *
+ * @param frame Snapshot to draw.
+ */
+void renderGameFrame(const GameFrame *frame)
+{
+    PROFILE_BEGIN(PROFILE_STAGE_RASTER);
+    drawGameFrame(frame);
+    PROFILE_END(PROFILE_STAGE_RASTER);
+
+    invertDisplay(frame->invert);
+
+    // Update Display
+    PROFILE_BEGIN(PROFILE_STAGE_FLUSH);
+    showDisplay();
+    PROFILE_END(PROFILE_STAGE_FLUSH);
+}
+
+/**
+ * @brief Draws the title screen, below the transition.
+ *
+ * @param name Name of the game, drawn as a wave.
+ * @param introTime Steps since the wave started (sets its phase).
+ * @param amplitude Amplitude of the wave.
+ * @param yAdd Distance the title still has to slide up.
+ * @param showPressStart Whether to show "Press Start" (it blinks).
+ */
+void drawTitleScreen(const char *name, int introTime, fixed_t amplitude, int yAdd, int showPressStart)
+{
+    int ang = introTime * 6;
+
+    // Background
+    drawStars(stars, MAX_STARS);
+
+    // PatroGalaxy Text
+    for (int i = 0; i < strlen(name); i++)
+    {
+        char letter[2] = {name[i], '\0'};
+        int _x = 64 - 5 * strlen(name) / 2 + 5 * i;
+        int _y = fxToInt(fxFromInt(SCREEN_HEIGHT / 2 + yAdd) + fxMul(fxSin(fxFromInt(ang + i * 60)), amplitude));
+        drawText(_x, _y, letter);
+    }
+
+    // Press Start
+    char startText[50];
+    sprintf(startText, "Press Start");
+    int _x = SCREEN_WIDTH / 2 - 5 * (strlen(startText) + 1) / 2;
+    int _y = SCREEN_HEIGHT - 10;
+    drawText(_x, _y, showPressStart ? startText : "");
+
+    // Draw Highscore
+    if (highScore > 0)
+    {
+        char highScoreText[50];
+        sprintf(highScoreText, "Highscore: %lu", (unsigned long)highScore);
+        _x = SCREEN_WIDTH / 2 - 5 * (strlen(highScoreText) + 1) / 2;
+        int _y = -8 + 15 - MIN(15, yAdd);
+        drawText(_x, _y, highScoreText);
+    }
+}
+
+/**
+ * @brief Draws the game over screen, below the transition.
+ *
+ * Shows the final score, and "New record!" when it beat the high score.
+ */
+void drawGameOverScreen()
+{
+    // Background
+    ssd1306_draw_square(&display, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    ssd1306_clear_square(&display, 8, 0, 2, SCREEN_HEIGHT);
+    ssd1306_clear_square(&display, 16, 0, 2, SCREEN_HEIGHT);
+    ssd1306_clear_square(&display, 20, 0, 2, SCREEN_HEIGHT);
+    ssd1306_clear_square(&display, SCREEN_WIDTH - 20 - 1, 0, 2, SCREEN_HEIGHT);
+    ssd1306_clear_square(&display, SCREEN_WIDTH - 16 - 1, 0, 2, SCREEN_HEIGHT);
+    ssd1306_clear_square(&display, SCREEN_WIDTH - 8 - 1, 0, 2, SCREEN_HEIGHT);
+
+    for (int i = 0; i < SCREEN_HEIGHT; i += 2)
+    {
+        ssd1306_clear_square(&display, 0, i, SCREEN_WIDTH, 1);
+    }
+
+    ssd1306_clear_square(&display, 24, 0, SCREEN_WIDTH - 48, SCREEN_HEIGHT);
+
+    // Game Over Text
+    char gameOverText[50];
+    sprintf(gameOverText, "Game Over");
+    int _x = SCREEN_WIDTH / 2 - 5 * (strlen(gameOverText) + 1) / 2;
+    int _y = SCREEN_HEIGHT / 2 - 6;
+    drawText(_x, _y, "Game Over");
+
+    char scoreText[50];
+    sprintf(scoreText, "Score: %d", score);
+    _x = SCREEN_WIDTH / 2 - 5 * (strlen(scoreText) + 1) / 2;
+    _y = SCREEN_HEIGHT / 2 - 6 + 12;
+    drawText(_x, _y, scoreText);
+
+    if (newHighScore)
+    {
+        char newRecordText[50];
+        sprintf(newRecordText, "New record!");
+        int _x = SCREEN_WIDTH / 2 - 5 * (strlen(newRecordText) + 1) / 2;
+        int _y = SCREEN_HEIGHT / 2 - 6 + 24;
+        drawText(_x, _y, newRecordText);
+    }
+}
+
 /**
  * @brief Main function of the PatroGalaxy game.
  *
@@ -315,13 +633,25 @@ int main()
     clearDisplay();
     initAnalog();
     initButtons(handleButtonGPIOEvent);
+
+#if INPUT_LOG_ENABLED && !defined(PATROGALAXY_HOST)
+    // Record from boot; the log is printed after every game
+    inputLogStartRecording();
+#endif
+    randomSeed(inputLogSeed(randomEntropySeed()));
+    // The seed reads the ADC once; the stick keeps it busy from here on
+    startAnalog();
+
     initStars();
+    initAsteroidSprites();
+    renderWorkerInit(renderGameFrame);
+    frameSchedulerInit();
 
     // Title Screen Variables
     int introTime;      // Time since the title screen started
     char patroName[50]; // Name of the game
     int showPressStart; // Flag to show the "Press Start" text
-    float amplitude;    // Amplitude of the title screen text
+    fixed_t amplitude;  // Amplitude of the title screen text
     int _yAdd;          // Y offset for the title screen text
 
     // Boot Screen
@@ -332,15 +662,17 @@ int main()
 
     // Splash Screen
     clearDisplay();
-    drawImage(ifpilogo_bmp_data, ifpilogo_bmp_size, 30, 0);
+    drawPackedImage(&ifpilogo_image, 30, 0);
     showDisplay();
     sleep_ms(3000);
 
     int splashTimer = 0;
     bool introPlayerInitialized = false;
     Player introPlayer = {.box = {.x = 0, .y = 0, .w = 16, .h = 16}};
+    frameSchedulerReset();
     while (splashTimer < 220)
     {
+        frameSchedulerBeginSingle();
         clearDisplay();
         int _y = 2;
         int _spac = 8;
@@ -353,8 +685,8 @@ int main()
         drawTextCentered("Patrocinio", _y);
 
         // Draw Playership
-        int _shipX = SCREEN_WIDTH / 2 - 6 + cos(splashTimer / 26.9) * 5;
-        int _shipY = SCREEN_HEIGHT / 2 + 8 + sin(splashTimer / 36.9) * 2;
+        int _shipX = fxToInt(fxFromInt(SCREEN_WIDTH / 2 - 6) + fxCos(fxDiv(fxFromInt(splashTimer), FX_CONST(26.9))) * 5);
+        int _shipY = fxToInt(fxFromInt(SCREEN_HEIGHT / 2 + 8) + fxSin(fxDiv(fxFromInt(splashTimer), FX_CONST(36.9))) * 2);
         introPlayer.box.x = _shipX;
         introPlayer.box.y = _shipY;
         if (!introPlayerInitialized)
@@ -363,13 +695,14 @@ int main()
             introPlayerInitialized = true;
         }
         drawPlayer(&introPlayer);
+        updatePlayerParticles(&introPlayer);
 
         _y = SCREEN_HEIGHT - 12;
         drawTextCentered("EmbarcaTech - 2025", _y);
 
         showDisplay();
         splashTimer += 1;
-        sleep_ms(STEP_CYCLE);
+        frameSchedulerEnd();
     }
 
     // Erase data when button A is pressed
@@ -378,220 +711,149 @@ int main()
         clearDisplay();
         drawText(0, 0, "Erasing data...");
         showDisplay();
-        clearSaveData();
+        saveDataClear();
         sleep_ms(2069);
     }
+    else
+    {
+        // The only flash read of the saves; a migrated one is rewritten on the title screen
+        saveDataLoad();
+        saveDataFlush();
+    }
 
     // Main Loop
     gameState = TITLE_SCREEN;
     while (true)
     {
         // Title Screen
+        frameSchedulerReset();
         while (gameState == TITLE_SCREEN)
         {
+            frameSchedulerBeginSingle();
+            PROFILE_POLL();
 
             if (!titleScreenInitialized)
             {
                 introTime = 0;
                 strcpy(patroName, "PatroGalaxy");
                 showPressStart = 0;
-                amplitude = 8.0;
+                amplitude = FX_FROM_INT(8);
                 _yAdd = 64;
                 lives = 3;
                 score = 0;
                 scoreDraw = 0;
-                gameSpeed = 1.0;
+                gameSpeed = FX_ONE;
                 newHighScore = false;
                 gameSaved = false;
+                asteroidsDestroyed = 0;
+                gameTicks = 0;
                 initPlayer(&player);
 
-                // Carregar Dados
-                uint8_t buffer[2];
-                loadProgress(buffer, 2);
-                loadBuffer(buffer, &highScore);
+                // The high score comes from the saves in RAM
+                highScore = saveDataHighScore();
 
                 titleScreenInitialized = true;
             }
+            processInput();
+
             clearDisplay();
-            int ang = introTime * 6;
             _yAdd = _yAdd > 0 ? _yAdd - 1 : 0;
 
-            // Background
-            moveStars(1.0);
-            drawStars();
+            moveStars(FX_ONE);
+            drawTitleScreen(patroName, introTime, amplitude, _yAdd, showPressStart);
 
-            // PatroGalaxy Text
-            for (int i = 0; i < strlen(patroName); i++)
-            {
-                char letter[2] = {patroName[i], '\0'};
-                int _x = 64 - 5 * strlen(patroName) / 2 + 5 * i;
-                int _y = SCREEN_HEIGHT / 2 + sin(ang + i * 60) * amplitude + _yAdd;
-                drawText(_x, _y, letter);
-            }
-
-            // Press Start
-            char startText[50];
-            sprintf(startText, "Press Start");
-            int _x = SCREEN_WIDTH / 2 - 5 * (strlen(startText) + 1) / 2;
-            int _y = SCREEN_HEIGHT - 10;
-            drawText(_x, _y, showPressStart ? startText : "");
-
-            // Draw Highscore
-            if (highScore > 0)
-            {
-                char highScoreText[50];
-                sprintf(highScoreText, "Highscore: %d", highScore);
-                _x = SCREEN_WIDTH / 2 - 5 * (strlen(highScoreText) + 1) / 2;
-                int _y = -8 + 15 - MIN(15, _yAdd);
-                drawText(_x, _y, highScoreText);
-            }
-
-            drawTransition();
+            updateTransition();
+            drawTransition(transitionProgress);
 
             introTime++;
 
-            amplitude = amplitude > 0 ? amplitude - 0.069 : 0;
+            amplitude = amplitude > 0 ? amplitude - FX_CONST(0.069) : 0;
 
             if (introTime > 30 && amplitude == 0)
             {
                 showPressStart = !showPressStart;
                 introTime = 0;
             }
+            endTick();
 
             showDisplay();
-            sleep_ms(STEP_CYCLE);
-        }
 
-        initAsteroids();
-
-        // Game State
-        while (gameState == GAME)
-        {
-            clearDisplay();
-
-            gameState = 1; // Game
-
-            // Increase game speed at each score interval
-            gameSpeed = 1.0 + (score / (300.0 + 100.0 * gameSpeed));
-
-            if (playerSpawnTime > 0)
+            // A save still queued (the game over was skipped) goes here; the next
+            // frame starts when the write ends, failed or not, with nothing to catch up
+            if (saveCommit() != SAVE_COMMIT_NONE)
             {
-                player.box.x = -40 + (30 - playerSpawnTime) * 2;
-                playerSpawnTime--;
+                frameSchedulerReset();
             }
-            // Background
-            moveStars(gameSpeed);
-            drawStars();
-
-            // Player
-            int canMove = (playerSpawnTime == 0);
-            if (canMove)
+            else
             {
-                updateAxis();
-                movePlayer(&player, analog_x, analog_y);
-            }
-
-            if (checkPlayerCollision(&player))
-            {
-                playerDeath();
-            }
-            shootCooldown = shootCooldown > 0 ? shootCooldown - 1 : 0;
-            playerInvulnerableTimer = playerInvulnerableTimer > 0 ? playerInvulnerableTimer - 1 : 0;
-
-            if (playerInvulnerableTimer % 2 == 0)
-            {
-                drawPlayer(&player);
-            }
-
-            // Asteroids
-            if (getAsteroidsActive() < MIN(3 + gameSpeed / 4, MAX_ASTEROIDS))
-            {
-                spawnAsteroid();
+                frameSchedulerEnd();
             }
+        }
 
-            // Update game entities
-            moveAsteroids(1 + gameSpeed / 4);
-            updateBullets();
+        initAsteroids();
 
-            if (checkBulletsCollisions())
+        // Game State
+        frameSchedulerReset();
+        while (gameState == GAME)
+        {
+            // Fixed simulation ticks, more than one when catching up
+            int ticks = frameSchedulerBegin();
+            PROFILE_BEGIN(PROFILE_STAGE_SIMULATION);
+            for (int i = 0; i < ticks && gameState == GAME; i++)
             {
-                score += 100;
+                updateGame();
             }
+            PROFILE_END(PROFILE_STAGE_SIMULATION);
 
-            // Draw game entities
-            drawAsteroids();
-            drawBullets();
-
-            // Draw Interface
-            drawInterface();
-
-            // Draw Transition Above Everything
-            drawTransition();
-
-            // Flash Screen
-            flashScreen = flashScreen > 0 ? flashScreen - 1 : 0;
-            invertDisplay(flashScreen);
-
-            // Update Display
-            showDisplay();
+            GameFrame *frame = renderWorkerAcquire();
+            captureGameFrame(frame);
+            renderWorkerSubmit(frame);
+            PROFILE_FRAME_END();
+            PROFILE_POLL();
 
-            // Sleep Step Cycle
-            sleep_ms(STEP_CYCLE);
+            // Sleep for what is left of the frame
+            frameSchedulerEnd();
         }
 
+        // Core0 draws the next screens itself
+        renderWorkerDrain();
+        frameSchedulerPrintStats();
+#if INPUT_LOG_ENABLED && !defined(PATROGALAXY_HOST)
+        inputLogDump(stdout);
+#endif
+
         int gameOverTime = 0;
         // Game Over
+        frameSchedulerReset();
         while (gameState == GAME_OVER)
         {
-            clearDisplay();
+            frameSchedulerBeginSingle();
+            PROFILE_POLL();
+            processInput();
 
-            // Background
-            if (gameOverTime > 0)
-            {
-            }
-            ssd1306_draw_square(&display, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+            clearDisplay();
             gameOverTime++;
             gameOverTime = gameOverTime > SCREEN_HEIGHT ? -16 : gameOverTime;
 
-            ssd1306_clear_square(&display, 8, 0, 2, SCREEN_HEIGHT);
-            ssd1306_clear_square(&display, 16, 0, 2, SCREEN_HEIGHT);
-            ssd1306_clear_square(&display, 20, 0, 2, SCREEN_HEIGHT);
-            ssd1306_clear_square(&display, SCREEN_WIDTH - 20 - 1, 0, 2, SCREEN_HEIGHT);
-            ssd1306_clear_square(&display, SCREEN_WIDTH - 16 - 1, 0, 2, SCREEN_HEIGHT);
-            ssd1306_clear_square(&display, SCREEN_WIDTH - 8 - 1, 0, 2, SCREEN_HEIGHT);
-
-            for (int i = 0; i < SCREEN_HEIGHT; i += 2)
-            {
-                ssd1306_clear_square(&display, 0, i, SCREEN_WIDTH, 1);
-            }
-
-            ssd1306_clear_square(&display, 24, 0, SCREEN_WIDTH - 48, SCREEN_HEIGHT);
+            drawGameOverScreen();
 
-            // Game Over Text
-            char gameOverText[50];
-            sprintf(gameOverText, "Game Over");
-            int _x = SCREEN_WIDTH / 2 - 5 * (strlen(gameOverText) + 1) / 2;
-            int _y = SCREEN_HEIGHT / 2 - 6;
-            drawText(_x, _y, "Game Over");
+            updateTransition();
+            endTick();
 
-            char scoreText[50];
-            sprintf(scoreText, "Score: %d", score);
-            _x = SCREEN_WIDTH / 2 - 5 * (strlen(scoreText) + 1) / 2;
-            _y = SCREEN_HEIGHT / 2 - 6 + 12;
-            drawText(_x, _y, scoreText);
+            drawTransition(transitionProgress);
+            showDisplay();
 
-            if (newHighScore)
+            // Once the transition is over the screen holds still, so the flash
+            // stall goes unseen; the next frame starts when the write ends,
+            // failed or not, with nothing to catch up
+            if (transitionProgress == 0 && transitioningToState == -1 && saveCommit() != SAVE_COMMIT_NONE)
             {
-                char newRecordText[50];
-                sprintf(newRecordText, "New record!");
-                int _x = SCREEN_WIDTH / 2 - 5 * (strlen(newRecordText) + 1) / 2;
-                int _y = SCREEN_HEIGHT / 2 - 6 + 24;
-                drawText(_x, _y, newRecordText);
+                frameSchedulerReset();
+            }
+            else
+            {
+                frameSchedulerEnd();
             }
-
-            drawTransition();
-            showDisplay();
-            sleep_ms(STEP_CYCLE);
         }
 
         clearDisplay();
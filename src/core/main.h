@@ -0,0 +1,65 @@
+/**
+ * @file main.h
+ * @brief Header file for the screens drawn by main.c.
+ *
+ * main.c owns the game state and the state loops; these are the pieces of
+ * it the host tools (benchmarks) call directly.
+ */
+
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fixedMath.h"
+#include "renderWorker.h"
+
+/** @brief The number of lives available to player */
+extern int lives;
+/** @brief The score of the game */
+extern int score;
+/** @brief Hightscore in a previous game */
+extern uint32_t highScore;
+/** @brief Flag for a new hightscore or not */
+extern bool newHighScore;
+
+/**
+ * @brief Runs one simulation step of the game state.
+ */
+void updateGame();
+
+/**
+ * @brief Copies the state needed to draw the game into a snapshot.
+ * @param frame Snapshot to fill.
+ */
+void captureGameFrame(GameFrame *frame);
+
+/**
+ * @brief Draws a gameplay frame from a snapshot into the display buffer.
+ * @param frame Snapshot to draw.
+ */
+void drawGameFrame(const GameFrame *frame);
+
+/**
+ * @brief Draws a gameplay frame from a snapshot and sends it to the display.
+ * @param frame Snapshot to draw.
+ */
+void renderGameFrame(const GameFrame *frame);
+
+/**
+ * @brief Draws the title screen, below the transition.
+ * @param name Name of the game, drawn as a wave.
+ * @param introTime Steps since the wave started.
+ * @param amplitude Amplitude of the wave.
+ * @param yAdd Distance the title still has to slide up.
+ * @param showPressStart Whether to show "Press Start".
+ */
+void drawTitleScreen(const char *name, int introTime, fixed_t amplitude, int yAdd, int showPressStart);
+
+/**
+ * @brief Draws the game over screen, below the transition.
+ */
+void drawGameOverScreen();
+
+#endif // MAIN_H
@@ -0,0 +1,175 @@
+/**
+ * @file renderWorker.c
+ * @brief Implementation for the render worker module.
+ *
+ * Frames are handed between the cores as slot indexes: core0 sends a filled
+ * slot to the worker and the worker sends it back once drawn, so each slot
+ * is only ever touched by one core at a time. The indexes travel through
+ * two lock-free rings in shared RAM, with __sev/__wfe to wake the waiting
+ * core. The SIO FIFOs are left alone: the flash lockout (see
+ * saveSystem.c) uses them, and its handler on core1 would swallow any
+ * other word.
+ */
+
+#include "renderWorker.h"
+#include "profiler.h"
+#include "spscRing.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+
+/** @brief Frame snapshots shared by the two cores. */
+static GameFrame frames[RENDER_SLOTS];
+/** @brief Function drawing the frames. */
+static RenderCallback renderCallback = NULL;
+
+#if PIPELINED_RENDER
+
+/** @brief Slots owned by core0 and ready to be filled. */
+static uint32_t freeSlots[RENDER_SLOTS];
+/** @brief Amount of entries in freeSlots. */
+static int freeCount = 0;
+
+/** @brief Stage times core1 spent on each slot, read by core0 once it is back. */
+static ProfileStages slotStages[RENDER_SLOTS];
+
+/** @brief Ring of slot indexes between the two cores. */
+SPSC_RING(SlotRing, slotRing, uint32_t, RENDER_SLOTS)
+
+/** @brief Filled slots, from core0 to the worker. */
+static SlotRing toWorker;
+/** @brief Drawn slots, from the worker back to core0. */
+static SlotRing toMain;
+
+/**
+ * @brief Pushes a slot and wakes the other core.
+ *
+ * Each ring has room for every slot, so the push can't fail.
+ */
+static void sendSlot(SlotRing *ring, uint32_t slot)
+{
+    slotRingPush(ring, slot);
+    __sev();
+}
+
+/**
+ * @brief Pops a slot, sleeping until the other core sends one.
+ */
+static uint32_t receiveSlot(SlotRing *ring)
+{
+    uint32_t slot;
+    while (!slotRingPop(ring, &slot))
+        __wfe();
+    return slot;
+}
+
+static void sendToWorker(uint32_t slot) { sendSlot(&toWorker, slot); }
+static uint32_t receiveOnWorker() { return receiveSlot(&toWorker); }
+static void sendToMain(uint32_t slot) { sendSlot(&toMain, slot); }
+
+/**
+ * @brief Takes a slot back from the worker, with the time it spent on it.
+ */
+static uint32_t receiveOnMain()
+{
+    uint32_t slot = receiveSlot(&toMain);
+    PROFILE_MERGE(&slotStages[slot]);
+    return slot;
+}
+
+/**
+ * @brief Worker loop: draws every slot received and sends it back.
+ */
+static void workerLoop()
+{
+    while (true)
+    {
+        uint32_t slot = receiveOnWorker();
+        renderCallback(&frames[slot]);
+        PROFILE_HAND_OFF(&slotStages[slot]);
+        sendToMain(slot);
+    }
+}
+
+/**
+ * @brief Entry point of core1.
+ */
+static void workerEntry()
+{
+    // Lets core0 pause this core while it writes to flash.
+    multicore_lockout_victim_init();
+    workerLoop();
+}
+
+/**
+ * @brief Launches the worker on core1 (a pthread on the host build).
+ */
+static void launchWorker()
+{
+    multicore_launch_core1(workerEntry);
+}
+
+#endif // PIPELINED_RENDER
+
+/**
+ * @brief Initializes the worker.
+ *
+ * In pipelined mode every slot starts free and the worker is launched
+ * on core1 (or a thread on the host build).
+ *
+ * @param render Function used to draw the submitted frames.
+ */
+void renderWorkerInit(RenderCallback render)
+{
+    renderCallback = render;
+#if PIPELINED_RENDER
+    for (int i = 0; i < RENDER_SLOTS; i++)
+        freeSlots[i] = i;
+    freeCount = RENDER_SLOTS;
+    launchWorker();
+#endif
+}
+
+/**
+ * @brief Gets a free snapshot to fill.
+ *
+ * Only waits when every slot is still queued or being drawn.
+ *
+ * @return Snapshot owned by the caller until submitted.
+ */
+GameFrame *renderWorkerAcquire()
+{
+#if PIPELINED_RENDER
+    if (freeCount == 0)
+        freeSlots[freeCount++] = receiveOnMain();
+    return &frames[freeSlots[--freeCount]];
+#else
+    return &frames[0];
+#endif
+}
+
+/**
+ * @brief Hands a filled snapshot to the worker.
+ *
+ * Without pipelining the frame is drawn right away on the calling core.
+ *
+ * @param frame Snapshot returned by renderWorkerAcquire().
+ */
+void renderWorkerSubmit(GameFrame *frame)
+{
+#if PIPELINED_RENDER
+    sendToWorker((uint32_t)(frame - frames));
+#else
+    renderCallback(frame);
+#endif
+}
+
+/**
+ * @brief Waits until every submitted frame has been drawn.
+ */
+void renderWorkerDrain()
+{
+#if PIPELINED_RENDER
+    while (freeCount < RENDER_SLOTS)
+        freeSlots[freeCount++] = receiveOnMain();
+#endif
+}
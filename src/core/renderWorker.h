@@ -0,0 +1,74 @@
+/**
+ * @file renderWorker.h
+ * @brief Header file for the render worker module.
+ *
+ * The render worker draws and flushes gameplay frames from snapshots of the
+ * entity state. With PIPELINED_RENDER enabled this happens on core1 while
+ * core0 simulates the next frame; otherwise frames are drawn inline.
+ */
+
+#ifndef RENDER_WORKER_H
+#define RENDER_WORKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "asteroids.h"
+#include "player.h"
+#include "background.h"
+
+/** @brief Set to 1 to rasterize and flush gameplay frames on core1. */
+#ifndef PIPELINED_RENDER
+#define PIPELINED_RENDER 0
+#endif
+
+/** @brief Number of frame snapshots in flight between the two cores. */
+#define RENDER_SLOTS 2
+
+/**
+ * @brief Snapshot of everything needed to draw a gameplay frame.
+ */
+typedef struct
+{
+    AsteroidStore asteroids; /**< Asteroids at the end of the tick. */
+    BulletStore bullets;     /**< Bullets at the end of the tick. */
+    Player player;           /**< Player and its particles. */
+    Star stars[MAX_STARS];   /**< Background stars. */
+    bool playerVisible;      /**< False on blinking invulnerability frames. */
+    int lives;               /**< Lives shown on the bottom bar. */
+    int scoreDraw;           /**< Animated score shown on the bottom bar. */
+    uint32_t highScore;      /**< High score shown on the header. */
+    int headerMode;          /**< Header mode (0 High Score, 1 Level Name). */
+    int transitionProgress;  /**< Progress of the screen transition. */
+    uint8_t invert;          /**< Whether the display is inverted (flash). */
+} GameFrame;
+
+/** @brief Function drawing and flushing a frame snapshot. */
+typedef void (*RenderCallback)(const GameFrame *frame);
+
+/**
+ * @brief Initializes the worker, launching core1 in pipelined mode.
+ * @param render Function used to draw the submitted frames.
+ */
+void renderWorkerInit(RenderCallback render);
+
+/**
+ * @brief Gets a free snapshot to fill, waiting for the worker if needed.
+ * @return Snapshot owned by the caller until submitted.
+ */
+GameFrame *renderWorkerAcquire();
+
+/**
+ * @brief Hands a filled snapshot to the worker.
+ * @param frame Snapshot returned by renderWorkerAcquire().
+ */
+void renderWorkerSubmit(GameFrame *frame);
+
+/**
+ * @brief Waits until every submitted frame has been drawn.
+ *
+ * Must be called before core0 draws to the display again.
+ */
+void renderWorkerDrain();
+
+#endif // RENDER_WORKER_H
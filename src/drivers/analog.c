@@ -4,16 +4,44 @@
  *
  * This module handles reading analog values from the analog stick
  * and applying a deadzone.
+ *
+ * The ADC runs in round-robin over ANALOG_INPUT_Y and ANALOG_INPUT_X, so
+ * the ring holds Y samples at even positions and X samples at odd ones.
+ * The data channel writes the ring with address wrapping and chains to a
+ * control channel that reloads its transfer count and retriggers it, so
+ * the capture never stops. The host has no DMA: there the latest value is
+ * read directly.
  */
 
 #include "analog.h"
 #include <stdio.h>
 
+#ifndef PATROGALAXY_HOST
+#include "hardware/dma.h"
+#endif
+
 /** @brief Store for last axis value - X*/
 int analog_x = 0;
 /** @brief Store for last axis value - Y */
 int analog_y = 0;
 
+/** @brief Axis value of each sample, by sample >> ANALOG_TABLE_SHIFT. */
+static int8_t axisTable[4096 >> ANALOG_TABLE_SHIFT];
+/** @brief Deadzone the table was built with. */
+static int32_t deadzone = DEADZONE;
+
+#ifndef PATROGALAXY_HOST
+/** @brief Samples written by DMA, aligned for the ring wrap. */
+static volatile uint16_t samples[ANALOG_RING_SAMPLES] __attribute__((aligned(ANALOG_RING_SAMPLES * sizeof(uint16_t))));
+/** @brief Transfer count the control channel reloads; even, to keep the channels in place. */
+static const uint32_t reloadCount = 0xFFFFFFFE;
+
+/**
+ * @brief Log2 of a power of two, at compile time.
+ */
+#define ANALOG_LOG2(n) ((n) >= 256 ? 8 : (n) >= 128 ? 7 : (n) >= 64 ? 6 : (n) >= 32 ? 5 : (n) >= 16 ? 4 : (n) >= 8 ? 3 : (n) >= 4 ? 2 : 1)
+#endif
+
 /**
  * @brief Initializes the analog inputs and button.
  *
@@ -21,6 +49,7 @@ int analog_y = 0;
  * the GPIO (General-Purpose Input/Output) pins for the analog inputs and button.
  * It initializes the ADC, sets up the GPIO pins for the analog X and Y inputs,
  * and configures the button pin as an input with a pull-up resistor.
+ * It also fills the axis table.
  */
 void initAnalog()
 {
@@ -30,41 +59,113 @@ void initAnalog()
     gpio_init(ANALOG_BTN);
     gpio_set_dir(ANALOG_BTN, GPIO_IN);
     gpio_pull_up(ANALOG_BTN);
+
+    setAnalogDeadzone(deadzone);
+}
+
+/**
+ * @brief Sets the deadzone and rebuilds the axis table.
+ *
+ * Maps the middle of each table step and applies the threshold to it.
+ *
+ * @param value Largest axis value read as 0.
+ */
+void setAnalogDeadzone(int32_t value)
+{
+    deadzone = value;
+    for (uint32_t i = 0; i < sizeof(axisTable); i++)
+    {
+        uint32_t sample = (i << ANALOG_TABLE_SHIFT) + (1 << ANALOG_TABLE_SHIFT) / 2;
+        axisTable[i] = applyThreshold(mapValue(sample, 0, 4095, -ANALOG_MAX_VALUE, ANALOG_MAX_VALUE));
+    }
+}
+
+/**
+ * @brief Starts sampling the stick in the background.
+ *
+ * Sets the ADC to round-robin into its FIFO and starts the DMA ring. On the
+ * host it does nothing.
+ */
+void startAnalog()
+{
+#ifndef PATROGALAXY_HOST
+    int dataChannel = dma_claim_unused_channel(true);
+    int controlChannel = dma_claim_unused_channel(true);
+
+    adc_select_input(ANALOG_INPUT_Y);
+    adc_set_round_robin((1 << ANALOG_INPUT_Y) | (1 << ANALOG_INPUT_X));
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(ANALOG_CLOCK_DIVIDER);
+
+    dma_channel_config data = dma_channel_get_default_config(dataChannel);
+    channel_config_set_transfer_data_size(&data, DMA_SIZE_16);
+    channel_config_set_read_increment(&data, false);
+    channel_config_set_write_increment(&data, true);
+    channel_config_set_ring(&data, true, ANALOG_LOG2(sizeof(samples)));
+    channel_config_set_dreq(&data, DREQ_ADC);
+    channel_config_set_chain_to(&data, controlChannel);
+    dma_channel_configure(dataChannel, &data, samples, &adc_hw->fifo, reloadCount, true);
+
+    dma_channel_config control = dma_channel_get_default_config(controlChannel);
+    channel_config_set_transfer_data_size(&control, DMA_SIZE_32);
+    channel_config_set_read_increment(&control, false);
+    channel_config_set_write_increment(&control, false);
+    dma_channel_configure(controlChannel, &control, &dma_hw->ch[dataChannel].al1_transfer_count_trig, &reloadCount, 1,
+                          false);
+
+    adc_run(true);
+#endif
+}
+
+/**
+ * @brief Latest filtered sample of an axis.
+ *
+ * Averages the channel's half of the ring, about the last 3 ms of samples,
+ * which filters the noise without a division.
+ *
+ * @param input ANALOG_INPUT_X or ANALOG_INPUT_Y.
+ * @return Average of the samples in the ring, 12 bits.
+ */
+uint16_t analogLatest(uint input)
+{
+#ifdef PATROGALAXY_HOST
+    adc_select_input(input);
+    return adc_read();
+#else
+    uint32_t sum = 0;
+    for (int i = input; i < ANALOG_RING_SAMPLES; i += 2)
+    {
+        sum += samples[i];
+    }
+    return sum >> ANALOG_LOG2(ANALOG_RING_SAMPLES / 2);
+#endif
 }
 
 /**
  * @brief Reads analog Y axis value.
  *
- * This function select the gpio that represents the axis Y, reads the adc value,
- * map the value from a range to another and after it apply a threshold to reduce sensibility
+ * Looks up the latest Y sample in the axis table, which maps it and applies
+ * the deadzone.
  *
  * @return The calibrated analog value for the Y axis, with deadzone applied.
- * @note The ANALOG_Y definition must be a valid ADC pin. This is a axis that must be inverted because of the analog system
+ * @note This is a axis that must be inverted because of the analog system
  */
 int32_t readAnalogY()
 {
-    adc_select_input(0);
-    uint32_t adc_value = adc_read();
-    int32_t mapped_value = mapValue(adc_value, 0, 4095, -ANALOG_MAX_VALUE, ANALOG_MAX_VALUE);
-    int32_t inverted_value = -mapped_value;
-    return applyThreshold(inverted_value);
+    return -axisTable[analogLatest(ANALOG_INPUT_Y) >> ANALOG_TABLE_SHIFT];
 }
 
 /**
  * @brief Reads analog X axis value.
  *
- * This function select the gpio that represents the axis X, reads the adc value,
- * map the value from a range to another and after it apply a threshold to reduce sensibility
+ * Looks up the latest X sample in the axis table, which maps it and applies
+ * the deadzone.
  *
  * @return The calibrated analog value for the X axis, with deadzone applied.
- * @note The ANALOG_X definition must be a valid ADC pin.
  */
 int32_t readAnalogX()
 {
-    adc_select_input(1);
-    uint32_t adc_value = adc_read();
-    int32_t mapped_value = mapValue(adc_value, 0, 4095, -ANALOG_MAX_VALUE, ANALOG_MAX_VALUE);
-    return applyThreshold(mapped_value);
+    return axisTable[analogLatest(ANALOG_INPUT_X) >> ANALOG_TABLE_SHIFT];
 }
 
 /**
@@ -78,7 +179,7 @@ int32_t readAnalogX()
  */
 int32_t applyThreshold(int32_t value)
 {
-    if (value > DEADZONE || value < -DEADZONE)
+    if (value > deadzone || value < -deadzone)
     {
         return value;
     }
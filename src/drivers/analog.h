@@ -1,6 +1,11 @@
 /**
  * @file analog.h
  * @brief Header file for the analog input module.
+ *
+ * On the device the ADC samples both stick channels in round-robin mode
+ * without stopping, and DMA copies the samples into a ring, so reading the
+ * stick never waits for a conversion. A precomputed table turns the
+ * averaged samples into axis values.
  */
 
 #ifndef ANALOG_H
@@ -19,9 +24,21 @@
 /** @brief Maximum value for analog input (used for mapping). */
 #define ANALOG_MAX_VALUE 5
 
-/** @brief Deadzone threshold for analog inputs. */
+/** @brief Default deadzone threshold for analog inputs. */
 #define DEADZONE 2
 
+/** @brief ADC input of the Y axis. */
+#define ANALOG_INPUT_Y 0
+/** @brief ADC input of the X axis. */
+#define ANALOG_INPUT_X 1
+
+/** @brief Samples in the DMA ring, both channels interleaved (a power of two). */
+#define ANALOG_RING_SAMPLES 64
+/** @brief ADC clock divider: 48 MHz / (1 + 2399), 20 k samples/s, 10 k per axis. */
+#define ANALOG_CLOCK_DIVIDER 2399
+/** @brief Low bits of a sample dropped to index the axis table. */
+#define ANALOG_TABLE_SHIFT 4
+
 /** @brief Last read value for axis X. */
 extern int analog_x;
 /** @brief Last read value for axis Y. */
@@ -30,12 +47,32 @@ extern int analog_y;
 /** @brief Initializes the analog inputs and button. */
 void initAnalog();
 
+/**
+ * @brief Starts sampling the stick in the background.
+ *
+ * Until then the ADC is free for one-off reads, like the entropy seed.
+ */
+void startAnalog();
+
+/**
+ * @brief Latest filtered sample of an axis.
+ * @param input ANALOG_INPUT_X or ANALOG_INPUT_Y.
+ * @return Average of the samples in the ring, 12 bits.
+ */
+uint16_t analogLatest(uint input);
+
 /** @brief Reads analog Y axis value. */
 int32_t readAnalogY();
 
 /** @brief Reads analog X axis value. */
 int32_t readAnalogX();
 
+/**
+ * @brief Sets the deadzone and rebuilds the axis table.
+ * @param value Largest axis value read as 0.
+ */
+void setAnalogDeadzone(int32_t value);
+
 /** @brief Applies a deadzone threshold to a value. */
 int32_t applyThreshold(int32_t value);
 
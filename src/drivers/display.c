@@ -9,8 +9,21 @@
  */
 
 #include "display.h"
+#ifdef PATROGALAXY_HOST
+#include "hostDisplay.h"
+#else
+#include "ssd1306_i2c_dma.h"
+#endif
 ssd1306_t display;
 
+#ifndef PATROGALAXY_HOST
+/** @brief DMA transport used to stream frames to the display. */
+static ssd1306_i2c_dma_t displayDma;
+#endif
+
+/** @brief Invert state last sent to the display (-1 if unknown). */
+static int displayInverted = -1;
+
 /**
  * @brief Initializes the I2C interface with a specified frequency and configures the GPIO pins.
  *
@@ -34,6 +47,9 @@ void initI2C()
  * @brief Initializes the SSD1306 display.
  *
  * This function initializes the SSD1306 display with the specified parameters.
+ * Frames are streamed with DMA, so showDisplay() returns while the previous
+ * frame is still being sent; if the DMA transport cannot be set up the
+ * driver falls back to blocking I2C writes.
  * It checks if the initialization is successful and prints a message accordingly.
  *
  * @note The function uses the global variables `display`, `SCREEN_WIDTH`, `SCREEN_HEIGHT`,
@@ -43,6 +59,17 @@ void initI2C()
  */
 void initDisplay()
 {
+#ifndef PATROGALAXY_HOST
+    if (ssd1306_i2c_dma_init(&displayDma, i2c1, SSD1306_BATCH_MAX_BYTES(SCREEN_WIDTH, SCREEN_HEIGHT)))
+    {
+        display.transport = ssd1306_i2c_dma_transport(&displayDma);
+    }
+    else
+    {
+        printf("Falha ao inicializar o DMA do display, usando I2C bloqueante\n");
+    }
+#endif
+
     if (!ssd1306_init(&display, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_ADDRESS, i2c1))
     {
         printf("Falha ao inicializar o display SSD1306\n");
@@ -67,12 +94,17 @@ void clearDisplay()
 /**
  * @brief Displays the content on the SSD1306 display.
  *
- * This function calls the ssd1306_display function with the global display
+ * This function calls the ssd1306_show function with the global display
  * variable to update the content shown on the SSD1306 OLED display.
+ * Only waits if the previous frame is still being transferred.
+ * On the host build the headless display then captures the frame.
  */
 void showDisplay()
 {
     ssd1306_show(&display);
+#ifdef PATROGALAXY_HOST
+    hostDisplayPresent();
+#endif
 }
 /**
  * @brief Inverts the display colors.
@@ -80,6 +112,8 @@ void showDisplay()
  * This function inverts the colors of the display. When the invert parameter
  * is set to a non-zero value, the display colors will be inverted. When the
  * invert parameter is set to zero, the display colors will return to normal.
+ * The command is only sent when the state changes, so calling it every frame
+ * does not wait for the frame being transferred.
  *
  * @param invert A uint8_t value indicating whether to invert the display colors.
  *               - 0: Normal display colors.
@@ -88,5 +122,10 @@ void showDisplay()
 
 void invertDisplay(uint8_t invert)
 {
-    ssd1306_invert(&display, invert);
+    int inverted = invert ? 1 : 0;
+    if (inverted == displayInverted)
+        return;
+
+    ssd1306_invert(&display, inverted);
+    displayInverted = inverted;
 }
\ No newline at end of file
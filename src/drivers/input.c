@@ -0,0 +1,104 @@
+/**
+ * @file input.c
+ * @brief Implementation for the per-tick input module.
+ *
+ * The ring is an SPSC_RING (see spscRing.h): the interrupt is its only
+ * producer and the game loop its only consumer.
+ */
+
+#include "input.h"
+#include "analog.h"
+#include "initialize.h"
+#include "spscRing.h"
+
+/** @brief Buttons the game reads, in INPUT_BUTTON_* order. */
+static const uint buttonPins[] = {BTA, BTB};
+/** @brief Number of buttons. */
+#define BUTTON_COUNT (sizeof(buttonPins) / sizeof(buttonPins[0]))
+
+/** @brief Ring of button edges. */
+SPSC_RING(EventRing, eventRing, InputEvent, INPUT_EVENT_CAPACITY)
+
+/** @brief Edges waiting for the next tick. */
+static EventRing edges;
+/** @brief Edges dropped on a full ring; written by the interrupt only. */
+static volatile uint32_t droppedEvents = 0;
+
+/** @brief Debounced level of each button: true while held down. */
+static bool buttonDown[BUTTON_COUNT];
+/** @brief Time of the last accepted edge of each button, of either kind. */
+static uint32_t lastAccepted[BUTTON_COUNT];
+/** @brief Whether an edge of each button was ever accepted. */
+static bool accepted[BUTTON_COUNT];
+
+/**
+ * @brief Pushes an edge, dropping it if the ring is full.
+ */
+static void pushEvent(uint gpio, InputEventKind kind, uint32_t time)
+{
+    if (!eventRingPush(&edges, (InputEvent){.time = time, .pin = gpio, .kind = kind}))
+        droppedEvents++;
+}
+
+void inputHandleGPIOEvent(uint gpio, uint32_t events)
+{
+    uint32_t time = time_us_32();
+
+    // Both edges can be pending at once; a press comes before its release
+    if (events & GPIO_IRQ_EDGE_FALL)
+        pushEvent(gpio, INPUT_EVENT_PRESS, time);
+    if (events & GPIO_IRQ_EDGE_RISE)
+        pushEvent(gpio, INPUT_EVENT_RELEASE, time);
+}
+
+uint32_t inputDroppedEvents()
+{
+    return droppedEvents;
+}
+
+/**
+ * @brief Takes every queued edge and debounces it.
+ * @return INPUT_BUTTON_* released since the last tick.
+ */
+static uint8_t drainEvents()
+{
+    uint8_t pressed = 0;
+    InputEvent event;
+
+    while (eventRingPop(&edges, &event))
+    {
+        for (unsigned button = 0; button < BUTTON_COUNT; button++)
+        {
+            if (event.pin != buttonPins[button])
+                continue;
+
+            // Only a change of level counts, and a contact bounces between
+            // both levels for a few milliseconds after any edge
+            bool down = event.kind == INPUT_EVENT_PRESS;
+            if (down == buttonDown[button])
+                break;
+            if (accepted[button] && event.time - lastAccepted[button] < INPUT_DEBOUNCE_US)
+                break;
+
+            accepted[button] = true;
+            lastAccepted[button] = event.time;
+            buttonDown[button] = down;
+            if (!down)
+                pressed |= 1 << button;
+            break;
+        }
+    }
+    return pressed;
+}
+
+InputTick inputSample()
+{
+    updateAxis();
+
+    InputTick tick = {.axisX = (int8_t)analog_x, .axisY = (int8_t)analog_y, .pressed = drainEvents()};
+    inputLogTick(&tick);
+
+    analog_x = tick.axisX;
+    analog_y = tick.axisY;
+    return tick;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file input.h
+ * @brief Header file for the per-tick input module.
+ *
+ * The GPIO interrupt only timestamps each button edge and pushes it to a
+ * single-producer single-consumer ring. Once per simulation tick the game
+ * drains the ring, debounces the edges on their timestamps and samples the
+ * stick, so it sees every input at a tick boundary. That makes a run depend
+ * only on the sequence of ticks, which is what the input log records and
+ * replays.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "pico/stdlib.h"
+#include "inputLog.h"
+
+/** @brief Events the ring holds between two ticks (a power of two). */
+#ifndef INPUT_EVENT_CAPACITY
+#define INPUT_EVENT_CAPACITY 32
+#endif
+
+/** @brief Shortest time between two accepted edges of a button, of any kind, in microseconds. */
+#ifndef INPUT_DEBOUNCE_US
+#define INPUT_DEBOUNCE_US 20000
+#endif
+
+/**
+ * @brief Kinds of button edges. The buttons short a pulled-up GPIO to
+ * ground, so a press falls.
+ */
+typedef enum
+{
+    INPUT_EVENT_PRESS,   /**< Falling edge. */
+    INPUT_EVENT_RELEASE, /**< Rising edge: what the game acts on. */
+} InputEventKind;
+
+/**
+ * @brief A button edge, as seen by the GPIO interrupt.
+ */
+typedef struct
+{
+    uint32_t time; /**< time_us_32 when the interrupt ran. */
+    uint8_t pin;   /**< GPIO of the button. */
+    uint8_t kind;  /**< InputEventKind. */
+} InputEvent;
+
+/**
+ * @brief Queues the edges of a button for the next tick.
+ *
+ * Called from the GPIO interrupt; it never blocks and never touches the
+ * game state. Edges that find the ring full are dropped and counted.
+ *
+ * @param gpio GPIO of the button.
+ * @param events GPIO_IRQ_EDGE_* that occurred.
+ */
+void inputHandleGPIOEvent(uint gpio, uint32_t events);
+
+/**
+ * @brief Number of edges dropped because the ring was full.
+ * @return Edges dropped since boot.
+ */
+uint32_t inputDroppedEvents();
+
+/**
+ * @brief Samples the input of a tick.
+ *
+ * Reads the stick into analog_x and analog_y and drains the button edges
+ * queued since the previous tick. A button counts as pressed in the tick
+ * when it was released after a press. An edge within INPUT_DEBOUNCE_US
+ * of the button's last accepted edge, of either kind, is a bounce. While
+ * replaying, both come from the input log.
+ *
+ * @return Input of the tick.
+ */
+InputTick inputSample();
+
+#endif // INPUT_H
@@ -0,0 +1,152 @@
+/**
+ * @file saveData.c
+ * @brief Implementation of the save data module.
+ */
+
+#include "saveData.h"
+#include "saveSystem.h"
+#include "saveManager.h"
+#include "analog.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+_Static_assert(sizeof(SaveData) <= SAVE_PAYLOAD_SIZE, "SaveData must fit in a save record");
+
+/** @brief RAM mirror of the saved data. */
+static SaveData saveData;
+/** @brief Whether saveData changed since it was last queued. */
+static bool dirty = false;
+
+/**
+ * @brief CRC of the saved data, everything after the crc field.
+ * @param data Saved data.
+ * @param size Bytes of it.
+ * @return CRC the data should carry.
+ */
+static uint32_t dataCrc(const uint8_t *data, size_t size)
+{
+    size_t start = offsetof(SaveData, crc) + sizeof(uint32_t);
+    return saveCrc32(0, data + start, size - start);
+}
+
+/**
+ * @brief Puts the defaults in the mirror: no scores, no statistics.
+ */
+static void setDefaults()
+{
+    memset(&saveData, 0, sizeof(saveData));
+    saveData.settings.deadzone = DEADZONE;
+}
+
+/**
+ * @brief Reads a stored block into the mirror, migrating older versions.
+ * @param data Payload of the newest save record.
+ * @param size Bytes of payload.
+ * @return false if the block is damaged or unknown.
+ */
+static bool readSaveData(const uint8_t *data, size_t size)
+{
+    // Saved before the schema: just the high score
+    if (size == SAVE_LEGACY_SIZE)
+    {
+        uint16_t highScore;
+        loadBuffer((uint8_t *)data, &highScore);
+        setDefaults();
+        if (highScore != 0xFFFF)
+        {
+            saveData.leaderboard[0].score = highScore;
+        }
+        printf("Save: pontuação antiga migrada (%u)\n", highScore);
+        dirty = true;
+        return true;
+    }
+
+    if (size < offsetof(SaveData, leaderboard))
+        return false;
+
+    SaveData stored;
+    memcpy(&stored, data, offsetof(SaveData, leaderboard));
+
+    // The version gives the layout, and so the size, before the CRC reads
+    // anything: a stored size is only trusted once it matches
+    switch (stored.version)
+    {
+    case 1:
+        if (stored.size != sizeof(SaveData) || stored.size > size || stored.crc != dataCrc(data, stored.size))
+            return false;
+        memcpy(&saveData, data, sizeof(SaveData));
+        return true;
+    default:
+        // Written by a newer build
+        return false;
+    }
+}
+
+void saveDataLoad()
+{
+    uint8_t data[SAVE_PAYLOAD_SIZE];
+    size_t size = loadProgress(data, sizeof(data));
+
+    // A migrated save is marked dirty, to be rewritten in the current version
+    setDefaults();
+    dirty = false;
+    if (size > 0 && !readSaveData(data, size))
+    {
+        printf("Save: dados inválidos, usando padrões\n");
+        setDefaults();
+    }
+    setAnalogDeadzone(saveData.settings.deadzone);
+}
+
+const SaveData *saveDataGet()
+{
+    return &saveData;
+}
+
+uint32_t saveDataHighScore()
+{
+    return saveData.leaderboard[0].score;
+}
+
+int saveDataRecordGame(uint32_t score, uint32_t asteroidsDestroyed, uint32_t ticks)
+{
+    saveData.stats.gamesPlayed++;
+    saveData.stats.totalScore += score;
+    saveData.stats.asteroidsDestroyed += asteroidsDestroyed;
+    saveData.stats.ticksPlayed += ticks;
+    dirty = true;
+
+    int place = 0;
+    while (place < LEADERBOARD_SIZE && saveData.leaderboard[place].score >= score)
+        place++;
+    if (place == LEADERBOARD_SIZE || score == 0)
+        return -1;
+
+    memmove(&saveData.leaderboard[place + 1], &saveData.leaderboard[place],
+            (LEADERBOARD_SIZE - place - 1) * sizeof(LeaderboardEntry));
+    saveData.leaderboard[place] = (LeaderboardEntry){.score = score, .game = saveData.stats.gamesPlayed};
+    return place;
+}
+
+bool saveDataFlush()
+{
+    if (!dirty)
+        return false;
+
+    saveData.version = SAVE_DATA_VERSION;
+    saveData.reserved = 0;
+    saveData.size = sizeof(SaveData);
+    saveData.crc = dataCrc((const uint8_t *)&saveData, sizeof(SaveData));
+    dirty = false;
+    return saveQueue((const uint8_t *)&saveData, sizeof(SaveData));
+}
+
+void saveDataClear()
+{
+    clearSaveData();
+    setDefaults();
+    dirty = false;
+    setAnalogDeadzone(saveData.settings.deadzone);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file saveData.h
+ * @brief Header file for the save data module.
+ *
+ * Everything the game keeps across power cycles: a leaderboard, lifetime
+ * statistics and settings. It is read from flash once at boot into a RAM
+ * mirror that the game reads and updates freely; changes mark it dirty and
+ * saveDataFlush queues it for writing only then.
+ *
+ * On flash it is a versioned block with a CRC, stored as the payload of a
+ * save record. Older versions, and the 2-byte high score saved before the
+ * schema existed, are migrated on load.
+ */
+
+#ifndef SAVE_DATA_H
+#define SAVE_DATA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Current version of the schema. */
+#define SAVE_DATA_VERSION 1
+
+/** @brief Scores kept on the leaderboard. */
+#define LEADERBOARD_SIZE 5
+
+/**
+ * @brief A leaderboard entry.
+ */
+typedef struct
+{
+    uint32_t score; /**< Final score, 0 for an empty entry. */
+    uint32_t game;  /**< Which game it was, counting from 1. */
+} LeaderboardEntry;
+
+/**
+ * @brief Lifetime statistics.
+ */
+typedef struct
+{
+    uint32_t gamesPlayed;        /**< Games finished. */
+    uint32_t totalScore;         /**< Sum of every final score. */
+    uint32_t asteroidsDestroyed; /**< Asteroids shot down. */
+    uint32_t ticksPlayed;        /**< Simulation ticks spent in games. */
+} SaveDataStats;
+
+/**
+ * @brief Player settings, applied at boot.
+ *
+ * Read-only for now: they keep the defaults, or whatever a save carries,
+ * until the game has a way to change them.
+ */
+typedef struct
+{
+    uint8_t deadzone;    /**< Stick deadzone, see setAnalogDeadzone. */
+    uint8_t reserved[3]; /**< Zero; room for settings to come. */
+} SaveDataSettings;
+
+/**
+ * @brief The saved data, as stored in flash.
+ */
+typedef struct
+{
+    uint8_t version;                              /**< SAVE_DATA_VERSION when written. */
+    uint8_t reserved;                             /**< Zero. */
+    uint16_t size;                                /**< sizeof(SaveData) when written. */
+    uint32_t crc;                                 /**< CRC-32 of everything after it. */
+    LeaderboardEntry leaderboard[LEADERBOARD_SIZE]; /**< Best scores, highest first. */
+    SaveDataStats stats;                          /**< Lifetime statistics. */
+    SaveDataSettings settings;                    /**< Player settings. */
+} SaveData;
+
+/**
+ * @brief Loads the saved data into RAM.
+ *
+ * Called once at boot. Data that is missing, damaged or from a newer
+ * version is replaced by the defaults.
+ */
+void saveDataLoad();
+
+/**
+ * @brief The RAM mirror of the saved data.
+ * @return Saved data, as loaded and updated since.
+ */
+const SaveData *saveDataGet();
+
+/**
+ * @brief Best score on the leaderboard.
+ * @return The high score, 0 if no game was played.
+ */
+uint32_t saveDataHighScore();
+
+/**
+ * @brief Adds a finished game to the leaderboard and statistics.
+ * @param score Final score.
+ * @param asteroidsDestroyed Asteroids shot down in the game.
+ * @param ticks Simulation ticks the game lasted.
+ * @return Place on the leaderboard (0 for the best), -1 if it didn't make it.
+ */
+int saveDataRecordGame(uint32_t score, uint32_t asteroidsDestroyed, uint32_t ticks);
+
+/**
+ * @brief Queues the saved data for writing if it changed.
+ *
+ * The write itself happens at the next saveCommit.
+ *
+ * @return true if something was queued.
+ */
+bool saveDataFlush();
+
+/**
+ * @brief Erases the saves and goes back to the defaults.
+ */
+void saveDataClear();
+
+#endif // SAVE_DATA_H
@@ -0,0 +1,72 @@
+/**
+ * @file saveManager.c
+ * @brief Implementation of the deferred save module.
+ *
+ * The flash writes themselves, with core1 locked out through
+ * multicore_lockout and interrupts disabled, are done by saveProgress.
+ */
+
+#include "saveManager.h"
+#include "saveSystem.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/** @brief Data waiting for the next safe point. */
+static uint8_t pendingData[SAVE_PAYLOAD_SIZE];
+/** @brief Bytes of pendingData. */
+static size_t pendingSize = 0;
+/** @brief Whether pendingData is waiting to be written. */
+static bool pending = false;
+
+/** @brief Save statistics since boot. */
+static SaveStats stats;
+
+bool saveQueue(const uint8_t *data, size_t size)
+{
+    if (size > sizeof(pendingData))
+        return false;
+
+    memcpy(pendingData, data, size);
+    pendingSize = size;
+    pending = true;
+    return true;
+}
+
+bool savePending()
+{
+    return pending;
+}
+
+SaveCommitResult saveCommit()
+{
+    if (!pending)
+        return SAVE_COMMIT_NONE;
+
+    uint32_t start = time_us_32();
+    bool saved = saveProgress(pendingData, pendingSize);
+    uint32_t stall = time_us_32() - start;
+
+    stats.lastStallUs = stall;
+    stats.worstStallUs = stall > stats.worstStallUs ? stall : stats.worstStallUs;
+    if (saved)
+    {
+        stats.commits++;
+        pending = false;
+    }
+    else
+    {
+        // Dropped: the log has no writable page, retrying won't help
+        stats.failures++;
+        pending = false;
+    }
+
+    printf("Save: %lu us de pausa (pior: %lu us)\n", (unsigned long)stats.lastStallUs,
+           (unsigned long)stats.worstStallUs);
+    return saved ? SAVE_COMMIT_DONE : SAVE_COMMIT_FAILED;
+}
+
+const SaveStats *saveStats()
+{
+    return &stats;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file saveManager.h
+ * @brief Header file for the deferred save module.
+ *
+ * Writing flash stalls the chip: code can't run from flash meanwhile, so
+ * interrupts are off and core1 is locked out for the whole erase or
+ * program, up to tens of milliseconds. The game queues its saves here
+ * instead and commits them at safe points outside the gameplay (the game
+ * over screen once its transition ends, or the title screen if that was
+ * skipped), so a save never costs a gameplay frame. Each commit measures
+ * how long it stalled.
+ */
+
+#ifndef SAVE_MANAGER_H
+#define SAVE_MANAGER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Save statistics since boot.
+ */
+typedef struct
+{
+    uint32_t commits;     /**< Records written. */
+    uint32_t failures;    /**< Commits that couldn't be written. */
+    uint32_t lastStallUs; /**< Stall of the last commit. */
+    uint32_t worstStallUs; /**< Longest stall of a commit. */
+} SaveStats;
+
+/**
+ * @brief What a call to saveCommit did.
+ */
+typedef enum
+{
+    SAVE_COMMIT_NONE,   /**< Nothing was queued; the flash wasn't touched. */
+    SAVE_COMMIT_DONE,   /**< The queued save was written. */
+    SAVE_COMMIT_FAILED, /**< The write stalled the chip but failed; the save is dropped. */
+} SaveCommitResult;
+
+/**
+ * @brief Queues data to be saved at the next safe point.
+ *
+ * Copies the data, so the caller's buffer can go. Data queued again before
+ * the commit replaces what was waiting.
+ *
+ * @param data Data to be saved.
+ * @param size Bytes of data, at most SAVE_PAYLOAD_SIZE.
+ * @return false if the data is too large.
+ */
+bool saveQueue(const uint8_t *data, size_t size);
+
+/**
+ * @brief Tells whether a save is waiting to be committed.
+ * @return true if saveCommit has something to write.
+ */
+bool savePending();
+
+/**
+ * @brief Writes the queued save, if any.
+ *
+ * Only call it where a stall of tens of milliseconds goes unnoticed, and
+ * restart the frame clock after any attempt, failed ones included, so the
+ * stall isn't caught up.
+ *
+ * @return SAVE_COMMIT_NONE if nothing was written, else how the write went.
+ */
+SaveCommitResult saveCommit();
+
+/**
+ * @brief Gets the save statistics.
+ * @return Statistics since boot.
+ */
+const SaveStats *saveStats();
+
+#endif // SAVE_MANAGER_H
@@ -5,80 +5,309 @@
  * This module provides functions for saving and loading game progress
  * to and from the Raspberry Pi Pico W's flash memory.  It also handles
  * the creation and loading of the game buffer.
+ *
+ * The ring is the SAVE_SECTORS sectors from FLASH_TARGET_OFFSET. Records
+ * take a whole page each, since a page is what flash_range_program writes.
  */
 
 #include "saveSystem.h"
 #include <string.h>
 #include <stdio.h>
+#include "pico/multicore.h"
 
 /**
- * @brief Saves the game progress to flash memory.
+ * @brief Pauses core1 before touching the flash.
  *
- * This function erases the flash sector and programs the provided
- * data, ensuring that interrupts are disabled during the operation.
+ * While the flash is being erased or programmed it can't be read, so core1
+ * must not run code from it. Only needed when core1 is running the render
+ * worker, which registers itself as a lockout victim.
  *
- * @param progressString Pointer to the data to be saved. Must be less than FLASH_PAGE_SIZE bytes.
- * @note It's crucial that progressString points to a valid buffer, and that its size is less than FLASH_PAGE_SIZE (256 bytes)
- * This function also uses interrupts and a printf command for debug porpuses.
+ * @return true if core1 was paused and must be resumed afterwards.
+ */
+static bool lockoutOtherCore()
+{
+    if (!multicore_lockout_victim_is_initialized(1))
+        return false;
+    multicore_lockout_start_blocking();
+    return true;
+}
+
+/**
+ * @brief Resumes core1 after a flash operation.
+ * @param locked Value returned by lockoutOtherCore().
  */
-void saveProgress(uint8_t *progressString)
+static void releaseOtherCore(bool locked)
 {
-    // Pause interruptions.
+    if (locked)
+        multicore_lockout_end_blocking();
+}
+
+/** @brief Whether the ring was scanned since boot. */
+static bool scanned = false;
+/** @brief Page of the newest record, -1 if there is none. */
+static int newestPage = -1;
+/** @brief Sequence of the newest record. */
+static uint32_t newestSequence = 0;
+/** @brief Page the next record is written to. */
+static int nextPage = 0;
+
+/**
+ * @brief Address a page of the ring is read at.
+ * @param page Page of the ring.
+ * @return Pointer into the flash.
+ */
+static const uint8_t *pageAddress(int page)
+{
+    return (const uint8_t *)(XIP_BASE + FLASH_TARGET_OFFSET + page * FLASH_PAGE_SIZE);
+}
+
+/**
+ * @brief Continues a CRC-32 (reflected, polynomial 0xEDB88320).
+ *
+ * Works a nibble at a time from a 16-entry table.
+ *
+ * @param crc CRC so far, 0 to start.
+ * @param data Bytes to add.
+ * @param size Number of bytes.
+ * @return Updated CRC.
+ */
+uint32_t saveCrc32(uint32_t crc, const uint8_t *data, size_t size)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = (crc >> 4) ^ table[(crc ^ data[i]) & 0x0F];
+        crc = (crc >> 4) ^ table[(crc ^ (data[i] >> 4)) & 0x0F];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief CRC of a record: its sequence, length and payload.
+ * @param header Header of the record.
+ * @param payload Payload of the record.
+ * @return CRC the header should carry.
+ */
+static uint32_t recordCrc(const SaveRecordHeader *header, const uint8_t *payload)
+{
+    uint32_t crc = saveCrc32(0, (const uint8_t *)&header->sequence, sizeof(header->sequence));
+    crc = saveCrc32(crc, (const uint8_t *)&header->length, sizeof(header->length));
+    return saveCrc32(crc, payload, header->length);
+}
+
+/**
+ * @brief Tells whether a page holds an intact record.
+ * @param page Page of the ring.
+ * @param header Filled with the record's header.
+ * @return true if the record is complete and its CRC matches.
+ */
+static bool readRecord(int page, SaveRecordHeader *header)
+{
+    const uint8_t *address = pageAddress(page);
+    memcpy(header, address, sizeof(*header));
+    return header->magic == SAVE_RECORD_MAGIC && header->length <= SAVE_PAYLOAD_SIZE &&
+           header->crc == recordCrc(header, address + sizeof(*header));
+}
+
+/**
+ * @brief Tells whether a range of the ring is erased.
+ * @param page First page.
+ * @param pages Number of pages.
+ * @return true if every byte reads 0xFF.
+ */
+static bool isErased(int page, int pages)
+{
+    const uint32_t *words = (const uint32_t *)pageAddress(page);
+    for (size_t i = 0; i < pages * FLASH_PAGE_SIZE / sizeof(uint32_t); i++)
+    {
+        if (words[i] != 0xFFFFFFFF)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Erases a sector of the ring.
+ * @param sector Sector of the ring.
+ */
+static void eraseSector(int sector)
+{
+    bool locked = lockoutOtherCore();
     uint32_t interruptions = save_and_disable_interrupts();
-    flash_range_erase(FLASH_TARGET_OFFSET, FLASH_SECTOR_SIZE);
-    flash_range_program(FLASH_TARGET_OFFSET, progressString, FLASH_PAGE_SIZE);
+    flash_range_erase(FLASH_TARGET_OFFSET + sector * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
     restore_interrupts(interruptions);
-    printf("Game saved.\n");
+    releaseOtherCore(locked);
+}
+
+/**
+ * @brief Finds the newest record and where the next one goes.
+ *
+ * Checks every page once and keeps the intact record with the highest
+ * sequence (compared with wraparound). The next record goes on the page
+ * after it; anything that isn't erased there is dealt with when writing.
+ */
+void initSaveSystem()
+{
+    newestPage = -1;
+    newestSequence = 0;
+
+    for (int page = 0; page < SAVE_PAGES; page++)
+    {
+        SaveRecordHeader header;
+        if (!readRecord(page, &header))
+            continue;
+        if (newestPage < 0 || (int32_t)(header.sequence - newestSequence) > 0)
+        {
+            newestPage = page;
+            newestSequence = header.sequence;
+        }
+    }
+
+    nextPage = newestPage < 0 ? 0 : (newestPage + 1) % SAVE_PAGES;
+    scanned = true;
+    printf("Save: %s (sequence %lu)\n", newestPage < 0 ? "nenhum registro" : "registro encontrado",
+           (unsigned long)newestSequence);
+}
+
+/**
+ * @brief Saves the game progress to flash memory.
+ *
+ * Appends a record on the next free page. A sector is erased when the log
+ * enters it, which is the only erase; a page left half written by a power
+ * loss is skipped. The newest record is never in the sector being erased,
+ * so a power loss at any point leaves the previous save readable.
+ *
+ * @param data Pointer to the data to be saved.
+ * @param size Bytes of data, at most SAVE_PAYLOAD_SIZE.
+ * @return true if the record was written and reads back intact.
+ * @note This function also uses interrupts and a printf command for debug porpuses.
+ */
+bool saveProgress(const uint8_t *data, size_t size)
+{
+    if (size > SAVE_PAYLOAD_SIZE)
+        return false;
+    if (!scanned)
+        initSaveSystem();
+
+    uint8_t page[FLASH_PAGE_SIZE];
+    SaveRecordHeader header = {
+        .magic = SAVE_RECORD_MAGIC,
+        .sequence = newestSequence + 1,
+        .length = size,
+        .reserved = 0xFFFF,
+    };
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page + sizeof(header), data, size);
+    header.crc = recordCrc(&header, page + sizeof(header));
+    memcpy(page, &header, sizeof(header));
+
+    for (int tries = 0; tries < SAVE_PAGES; tries++)
+    {
+        int target = nextPage;
+        nextPage = (nextPage + 1) % SAVE_PAGES;
+
+        if (target % SAVE_PAGES_PER_SECTOR == 0)
+        {
+            // The log wrapped into this sector: its records are the oldest
+            if (!isErased(target, SAVE_PAGES_PER_SECTOR))
+                eraseSector(target / SAVE_PAGES_PER_SECTOR);
+        }
+        else if (!isErased(target, 1))
+        {
+            continue;
+        }
+
+        // Pause the other core and interruptions.
+        bool locked = lockoutOtherCore();
+        uint32_t interruptions = save_and_disable_interrupts();
+        flash_range_program(FLASH_TARGET_OFFSET + target * FLASH_PAGE_SIZE, page, FLASH_PAGE_SIZE);
+        restore_interrupts(interruptions);
+        releaseOtherCore(locked);
+
+        SaveRecordHeader written;
+        if (!readRecord(target, &written))
+            continue;
+
+        newestPage = target;
+        newestSequence = header.sequence;
+        printf("Game saved.\n");
+        return true;
+    }
+
+    printf("Save failed.\n");
+    return false;
 }
 
 /**
  * @brief Loads the game progress from flash memory.
  *
- * This function copies the saved data from flash memory into the provided buffer.
+ * Copies the payload of the newest record into the buffer. Without any
+ * record, a save written before the log (the SAVE_LEGACY_SIZE raw bytes at
+ * the start of the first sector) is loaded instead, so an update keeps the
+ * high score.
  *
  * @param buffer Pointer to the buffer where the loaded data will be stored.
- * @param tamanho The number of bytes to load.
+ * @param tamanho The number of bytes to load; bytes past the record are zeroed.
+ * @return Bytes the record holds, 0 if there is no save at all.
  * @note It is important that a valid buffer is provided and that it has already been declared and initialized.
  * This function access a flash memory area.
  */
-void loadProgress(uint8_t *buffer, size_t tamanho)
+size_t loadProgress(uint8_t *buffer, size_t tamanho)
 {
-    // Encontrar o local exato da memoria flash onde está o save
-    uint8_t *address = (uint8_t *)(XIP_BASE + FLASH_TARGET_OFFSET);
-    memcpy(buffer, address, tamanho);
+    if (!scanned)
+        initSaveSystem();
+
+    memset(buffer, 0, tamanho);
+    if (newestPage >= 0)
+    {
+        const uint8_t *address = pageAddress(newestPage);
+        size_t length = ((const SaveRecordHeader *)address)->length;
+        memcpy(buffer, address + sizeof(SaveRecordHeader), MIN(length, tamanho));
+        return length;
+    }
+
+    // Encontrar o save antigo, gravado direto no início do setor. A program
+    // cut short only clears bits, so a first word that still holds every bit
+    // of the magic is a torn record, not an old save.
+    const uint8_t *address = pageAddress(0);
+    uint32_t magic;
+    memcpy(&magic, address, sizeof(magic));
+    if (isErased(0, 1) || (magic & SAVE_RECORD_MAGIC) == SAVE_RECORD_MAGIC)
+        return 0;
+    memcpy(buffer, address, MIN(tamanho, SAVE_LEGACY_SIZE));
+    return SAVE_LEGACY_SIZE;
 }
 
 /**
  * @brief Clears the saved game data in flash memory.
  *
- * This function erases the flash sector, effectively resetting the
+ * This function erases every sector of the ring, effectively resetting the
  * game's saved progress.
  *
  * @note It is important to use only to erase data of a game or save, don't use if to erase core functions of SO.
  */
 void clearSaveData()
 {
-    // Find the exact location in flash memory where the save is
-    uint32_t interruptions = save_and_disable_interrupts();
-    flash_range_erase(FLASH_TARGET_OFFSET, FLASH_SECTOR_SIZE);
-    flash_range_program(FLASH_TARGET_OFFSET, 0x00, FLASH_PAGE_SIZE);
-    restore_interrupts(interruptions);
+    for (int sector = 0; sector < SAVE_SECTORS; sector++)
+    {
+        eraseSector(sector);
+    }
+    newestPage = -1;
+    newestSequence = 0;
+    nextPage = 0;
+    scanned = true;
 }
 
-/**
- * @brief Creates a buffer containing the highscore.
- *
- * This function convert a number to array in order to save it to the Flash memory.
- * The highscore is saved as an uint16, but it is converted to a 2-byte array in this function.
- *
- * @param highscore The highscore number to be added to the array
- * @param buffer The created array
- * @note For performance and clear memory pourpouses, array size is 2
- */
-void createBuffer(uint16_t highscore, uint8_t *buffer)
+uint32_t saveSequence()
 {
-    buffer[0] = (highscore >> 8) & 0xFF;
-    buffer[1] = highscore & 0xFF;
+    if (!scanned)
+        initSaveSystem();
+    return newestPage < 0 ? 0 : newestSequence;
 }
 
 /**
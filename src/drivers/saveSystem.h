@@ -1,6 +1,12 @@
 /**
  * @file saveSystem.h
  * @brief Header file for the save system module.
+ *
+ * Saves are appended as records to a log that runs around a ring of flash
+ * sectors, one record per page. Each record carries a sequence number and
+ * a CRC, so the newest intact record wins and a write cut short by a power
+ * loss is simply skipped. A sector is only erased when the log wraps into
+ * it, which spreads the wear over the whole ring.
  */
 
 #ifndef SAVESYSTEM_H
@@ -21,18 +27,59 @@
  */
 #define FLASH_TARGET_OFFSET (512 * 1024)
 
+/** @brief Sectors in the save ring (at least 2, so a wrap never erases the newest record). */
+#ifndef SAVE_SECTORS
+#define SAVE_SECTORS 4
+#endif
+
+/** @brief Pages, and so records, in one sector. */
+#define SAVE_PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+/** @brief Pages in the save ring. */
+#define SAVE_PAGES (SAVE_SECTORS * SAVE_PAGES_PER_SECTOR)
+
+/** @brief Marks the start of a record ("PGSV"). */
+#define SAVE_RECORD_MAGIC 0x56534750u
+
+/**
+ * @brief Header at the start of every record page.
+ */
+typedef struct
+{
+    uint32_t magic;    /**< SAVE_RECORD_MAGIC. */
+    uint32_t sequence; /**< Grows by one with every record. */
+    uint16_t length;   /**< Bytes of payload after the header. */
+    uint16_t reserved; /**< Left erased. */
+    uint32_t crc;      /**< CRC-32 of sequence, length and the payload. */
+} SaveRecordHeader;
+
+/** @brief Most bytes a record holds. */
+#define SAVE_PAYLOAD_SIZE (FLASH_PAGE_SIZE - sizeof(SaveRecordHeader))
+
+/** @brief Bytes of the save written before the log: a big-endian high score. */
+#define SAVE_LEGACY_SIZE 2
+
+/**
+ * @brief Finds the newest record and where the next one goes.
+ *
+ * Reads the ring once. The other functions call it on first use.
+ */
+void initSaveSystem();
+
 /**
  * @brief Saves the game progress to flash memory.
- * @param progressString Data to be saved.
+ * @param data Data to be saved.
+ * @param size Bytes of data, at most SAVE_PAYLOAD_SIZE.
+ * @return true if the record was written and reads back intact.
  */
-void saveProgress(uint8_t *progressString);
+bool saveProgress(const uint8_t *data, size_t size);
 
 /**
  * @brief Loads the game progress from flash memory.
  * @param buffer Buffer for loaded data.
  * @param size Number of bytes to load.
+ * @return Bytes the newest record holds, 0 if there is none.
  */
-void loadProgress(uint8_t *buffer, size_t size);
+size_t loadProgress(uint8_t *buffer, size_t size);
 
 /**
  * @brief Clears the saved game data in flash memory.
@@ -40,11 +87,19 @@ void loadProgress(uint8_t *buffer, size_t size);
 void clearSaveData();
 
 /**
- * @brief Creates a buffer containing the highscore.
- * @param highscore The highscore number.
- * @param buffer The created array
+ * @brief Sequence number of the newest record.
+ * @return Its sequence, 0 if there is no record.
+ */
+uint32_t saveSequence();
+
+/**
+ * @brief Continues a CRC-32 (the zlib one).
+ * @param crc CRC so far, 0 to start.
+ * @param data Bytes to add.
+ * @param size Number of bytes.
+ * @return Updated CRC.
  */
-void createBuffer(uint16_t highscore, uint8_t *buffer);
+uint32_t saveCrc32(uint32_t crc, const uint8_t *data, size_t size);
 
 /**
  * @brief Loads the number from the buffer array.
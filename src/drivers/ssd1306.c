@@ -33,10 +33,13 @@ SOFTWARE.
 #include "ssd1306.h"
 #include "font.h"
 
+// commands setting a column/page window: SET_COL_ADDR, start, end, SET_PAGE_ADDR, start, end
+#define SSD1306_WINDOW_COMMANDS 6
+
 inline static void swap(int32_t *a, int32_t *b) {
-    int32_t *t=a;
+    int32_t t=*a;
     *a=*b;
-    *b=*t;
+    *b=t;
 }
 
 inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
@@ -53,9 +56,46 @@ inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src
     }
 }
 
-inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
-    uint8_t d[2]= {0x00, val};
-    fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
+// i2c_write_blocking needs each transaction in one piece, so it is staged first
+static void ssd1306_i2c_submit(void *ctx, uint8_t address, const ssd1306_transaction_t *transactions, size_t count) {
+    ssd1306_t *p=ctx;
+    for(size_t i=0; i<count; ++i) {
+        p->staging[0]=transactions[i].control;
+        memcpy(p->staging+1, transactions[i].data, transactions[i].len);
+        fancy_write(p->i2c_i, address, p->staging, transactions[i].len+1, "ssd1306_i2c_submit");
+    }
+}
+
+static bool ssd1306_i2c_busy(void *ctx) {
+    return false;
+}
+
+static void ssd1306_submit(ssd1306_t *p, const ssd1306_transaction_t *transactions, size_t count) {
+    p->transport.submit(p->transport.ctx, p->address, transactions, count);
+    p->stats.last_transactions=count;
+    p->stats.total_transactions+=count;
+}
+
+inline void ssd1306_cmdlist_init(ssd1306_cmdlist_t *l) {
+    l->data[0]=0x00;
+    l->len=0;
+}
+
+inline bool ssd1306_cmdlist_add(ssd1306_cmdlist_t *l, uint8_t cmd) {
+    if(l->len>=SSD1306_CMDLIST_MAX)
+        return false;
+    l->data[1+l->len++]=cmd;
+    return true;
+}
+
+void ssd1306_cmdlist_send(ssd1306_t *p, const ssd1306_cmdlist_t *l) {
+    ssd1306_transaction_t t= {l->data+1, l->len, l->data[0]};
+    if(l->len)
+        ssd1306_submit(p, &t, 1);
+}
+
+inline uint32_t ssd1306_last_transactions(ssd1306_t *p) {
+    return p->stats.last_transactions;
 }
 
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
@@ -68,12 +108,27 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
 
     p->bufsize=(p->pages)*(p->width);
-    if((p->buffer=malloc(p->bufsize+1))==NULL) {
+    p->staging=NULL;
+    if(p->transport.submit==NULL) {
+        p->transport.submit=ssd1306_i2c_submit;
+        p->transport.busy=ssd1306_i2c_busy;
+        p->transport.ctx=p;
+        p->staging=malloc(1+p->bufsize);
+    }
+
+    p->buffer=malloc(p->bufsize);
+    p->front=malloc(p->bufsize);
+    p->windows=malloc(SSD1306_WINDOW_COMMANDS*p->pages);
+    p->transactions=malloc(2*p->pages*sizeof(ssd1306_transaction_t));
+    if(p->buffer==NULL || p->front==NULL || p->windows==NULL || p->transactions==NULL ||
+       (p->transport.submit==ssd1306_i2c_submit && p->staging==NULL)) {
+        ssd1306_deinit(p);
         p->bufsize=0;
         return false;
     }
 
-    ++(p->buffer);
+    p->front_valid=false;
+    memset(&p->stats, 0, sizeof(p->stats));
 
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
@@ -109,31 +164,55 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         0x00,  // horizontal
     };
 
+    ssd1306_cmdlist_t l;
+    ssd1306_cmdlist_init(&l);
     for(size_t i=0; i<sizeof(cmds); ++i)
-        ssd1306_write(p, cmds[i]);
+        ssd1306_cmdlist_add(&l, cmds[i]);
+    ssd1306_cmdlist_send(p, &l);
 
     return true;
 }
 
 inline void ssd1306_deinit(ssd1306_t *p) {
-    free(p->buffer-1);
+    while(p->transport.busy(p->transport.ctx))
+        tight_loop_contents();
+
+    free(p->buffer);
+    free(p->front);
+    free(p->windows);
+    free(p->transactions);
+    free(p->staging);
+    p->buffer=p->front=p->windows=p->staging=NULL;
+    p->transactions=NULL;
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
-    ssd1306_write(p, SET_DISP|0x00);
+    ssd1306_cmdlist_t l;
+    ssd1306_cmdlist_init(&l);
+    ssd1306_cmdlist_add(&l, SET_DISP|0x00);
+    ssd1306_cmdlist_send(p, &l);
 }
 
 inline void ssd1306_poweron(ssd1306_t *p) {
-    ssd1306_write(p, SET_DISP|0x01);
+    ssd1306_cmdlist_t l;
+    ssd1306_cmdlist_init(&l);
+    ssd1306_cmdlist_add(&l, SET_DISP|0x01);
+    ssd1306_cmdlist_send(p, &l);
 }
 
 inline void ssd1306_contrast(ssd1306_t *p, uint8_t val) {
-    ssd1306_write(p, SET_CONTRAST);
-    ssd1306_write(p, val);
+    ssd1306_cmdlist_t l;
+    ssd1306_cmdlist_init(&l);
+    ssd1306_cmdlist_add(&l, SET_CONTRAST);
+    ssd1306_cmdlist_add(&l, val);
+    ssd1306_cmdlist_send(p, &l);
 }
 
 inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
-    ssd1306_write(p, SET_NORM_INV | (inv & 1));
+    ssd1306_cmdlist_t l;
+    ssd1306_cmdlist_init(&l);
+    ssd1306_cmdlist_add(&l, SET_NORM_INV | (inv & 1));
+    ssd1306_cmdlist_send(p, &l);
 }
 
 inline void ssd1306_clear(ssd1306_t *p) {
@@ -152,38 +231,210 @@ void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
     p->buffer[x+p->width*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
 }
 
+// cohen-sutherland region codes
+#define SSD1306_OUT_LEFT 1
+#define SSD1306_OUT_RIGHT 2
+#define SSD1306_OUT_TOP 4
+#define SSD1306_OUT_BOTTOM 8
+
+static inline uint8_t ssd1306_outcode(const ssd1306_t *p, int32_t x, int32_t y) {
+    uint8_t code=0;
+    if(x<0)
+        code|=SSD1306_OUT_LEFT;
+    else if(x>=p->width)
+        code|=SSD1306_OUT_RIGHT;
+    if(y<0)
+        code|=SSD1306_OUT_TOP;
+    else if(y>=p->height)
+        code|=SSD1306_OUT_BOTTOM;
+    return code;
+}
+
+static inline void ssd1306_plot(ssd1306_t *p, int32_t x, int32_t y) {
+    p->buffer[x+p->width*(y>>3)]|=0x1<<(y&0x07);
+}
+
+/*
+ * the line is walked along its major axis a in steps k=0..da; after k steps
+ * the minor axis b has moved n(k)=floor((2*db*k+da-1)/(2*da)) pixels, which
+ * is exactly what the bresenham error term produces. inverting n(k) gives
+ * the steps for which b stays on the panel, so a clipped line starts at its
+ * first visible pixel and stops after its last one.
+ */
+static inline int32_t ssd1306_minor_steps(int64_t k, int64_t da, int64_t db) {
+    return (int32_t) ((2*db*k+da-1)/(2*da));
+}
+
+/*
+ * bresenham error term after k steps, n of them on the minor axis. the
+ * products need 64 bits once the first visible step is far along, but the
+ * term itself stays within (2*db-2*da, 2*db], as it does along the loop.
+ */
+static inline int32_t ssd1306_line_error(int64_t k, int64_t n, int64_t da, int64_t db) {
+    return (int32_t) (2*db*(k+1)-da-2*da*n);
+}
+
+static bool ssd1306_clip_steps(int32_t a, int32_t sa, int32_t a_size, int32_t da,
+                               int32_t b, int32_t sb, int32_t b_size, int32_t db,
+                               int32_t *k_first, int32_t *k_last) {
+    // steps keeping the major axis on the panel
+    int64_t lo=sa>0?-(int64_t) a:(int64_t) a-(a_size-1);
+    int64_t hi=sa>0?(int64_t) a_size-1-a:(int64_t) a;
+
+    // minor axis movement allowed before leaving the panel
+    int64_t m_lo=sb>0?-(int64_t) b:(int64_t) b-(b_size-1);
+    int64_t m_hi=sb>0?(int64_t) b_size-1-b:(int64_t) b;
+    if(m_hi<0)
+        return false;
+
+    // first step with n(k)>=m_lo and last step with n(k)<=m_hi
+    if(m_lo>0) {
+        int64_t first=(2*(int64_t) da*m_lo-da+1+2*(int64_t) db-1)/(2*(int64_t) db);
+        if(first>lo)
+            lo=first;
+    }
+    int64_t last=((int64_t) da*(2*m_hi+1))/(2*(int64_t) db);
+    if(last<hi)
+        hi=last;
+
+    if(lo<0)
+        lo=0;
+    if(hi>da)
+        hi=da;
+    if(lo>hi)
+        return false;
+
+    *k_first=(int32_t) lo;
+    *k_last=(int32_t) hi;
+    return true;
+}
+
 void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
-    if(x1>x2) {
-        swap(&x1, &x2);
-        swap(&y1, &y2);
+    if(y1==y2) {
+        if(x1>x2)
+            swap(&x1, &x2);
+        ssd1306_fill_rect(p, x1, y1, x2-x1+1, 1, SSD1306_FILL_SET);
+        return;
     }
 
     if(x1==x2) {
         if(y1>y2)
             swap(&y1, &y2);
-        for(int32_t i=y1; i<=y2; ++i)
-            ssd1306_draw_pixel(p, x1, i);
+        ssd1306_fill_rect(p, x1, y1, 1, y2-y1+1, SSD1306_FILL_SET);
         return;
     }
 
-    float m=(float) (y2-y1) / (float) (x2-x1);
+    uint8_t code1=ssd1306_outcode(p, x1, y1), code2=ssd1306_outcode(p, x2, y2);
+    if(code1&code2) // both ends on the same outer side
+        return;
+
+    const int32_t dx=x2>x1?x2-x1:x1-x2, dy=y2>y1?y2-y1:y1-y2;
+    const int32_t sx=x2>x1?1:-1, sy=y2>y1?1:-1;
+    int32_t k_first=0, k_last;
+
+    if(dx>=dy) {
+        k_last=dx;
+        if((code1|code2) && !ssd1306_clip_steps(x1, sx, p->width, dx, y1, sy, p->height, dy, &k_first, &k_last))
+            return;
+
+        int32_t n=ssd1306_minor_steps(k_first, dx, dy);
+        int32_t x=x1+sx*k_first, y=y1+sy*n;
+        int32_t err=ssd1306_line_error(k_first, n, dx, dy);
+        for(int32_t k=k_first; k<=k_last; ++k, x+=sx) {
+            ssd1306_plot(p, x, y);
+            if(err>0) {
+                y+=sy;
+                err-=2*dx;
+            }
+            err+=2*dy;
+        }
+    } else {
+        k_last=dy;
+        if((code1|code2) && !ssd1306_clip_steps(y1, sy, p->height, dy, x1, sx, p->width, dx, &k_first, &k_last))
+            return;
+
+        int32_t n=ssd1306_minor_steps(k_first, dy, dx);
+        int32_t y=y1+sy*k_first, x=x1+sx*n;
+        int32_t err=ssd1306_line_error(k_first, n, dy, dx);
+        for(int32_t k=k_first; k<=k_last; ++k, y+=sy) {
+            ssd1306_plot(p, x, y);
+            if(err>0) {
+                x+=sx;
+                err-=2*dy;
+            }
+            err+=2*dx;
+        }
+    }
+}
+
+// flips every bit of a span, a word at a time once the pointer is aligned
+static void ssd1306_invert_span(uint8_t *dst, size_t len) {
+    while(len && ((uintptr_t) dst&3)) {
+        *dst++^=0xFF;
+        --len;
+    }
+    for(uint32_t *word=(uint32_t *) dst; len>=4; len-=4, dst+=4)
+        *word++^=0xFFFFFFFF;
+    while(len--)
+        *dst++^=0xFF;
+}
+
+void ssd1306_fill_rect(ssd1306_t *p, int32_t x, int32_t y, int32_t width, int32_t height, ssd1306_fill_mode_t mode) {
+    if(width<=0 || height<=0)
+        return;
+
+    int64_t x_end=(int64_t) x+width, y_end=(int64_t) y+height;
+    int32_t x0=x<0?0:x, y0=y<0?0:y;
+    int32_t x1=x_end>p->width?p->width:(int32_t) x_end;
+    int32_t y1=y_end>p->height?p->height:(int32_t) y_end;
+    if(x0>=x1 || y0>=y1)
+        return;
 
-    for(int32_t i=x1; i<=x2; ++i) {
-        float y=m*(float) (i-x1)+(float) y1;
-        ssd1306_draw_pixel(p, i, (uint32_t) y);
+    const size_t len=x1-x0;
+    const uint32_t first_page=y0>>3, last_page=(y1-1)>>3;
+    const uint8_t top_mask=0xFF<<(y0&7);
+    const uint8_t bottom_mask=0xFF>>(7-((y1-1)&7));
+
+    for(uint32_t page=first_page; page<=last_page; ++page) {
+        uint8_t mask=0xFF;
+        if(page==first_page)
+            mask&=top_mask;
+        if(page==last_page)
+            mask&=bottom_mask;
+
+        uint8_t *row=p->buffer+page*p->width+x0;
+        switch(mode) {
+        case SSD1306_FILL_SET:
+            if(mask==0xFF)
+                memset(row, 0xFF, len);
+            else
+                for(size_t i=0; i<len; ++i)
+                    row[i]|=mask;
+            break;
+        case SSD1306_FILL_CLEAR:
+            if(mask==0xFF)
+                memset(row, 0x00, len);
+            else
+                for(size_t i=0; i<len; ++i)
+                    row[i]&=~mask;
+            break;
+        case SSD1306_FILL_INVERT:
+            if(mask==0xFF)
+                ssd1306_invert_span(row, len);
+            else
+                for(size_t i=0; i<len; ++i)
+                    row[i]^=mask;
+            break;
+        }
     }
 }
 
 void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_clear_pixel(p, x+i, y+j);
+    ssd1306_fill_rect(p, (int32_t) x, (int32_t) y, (int32_t) width, (int32_t) height, SSD1306_FILL_CLEAR);
 }
 
 void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_draw_pixel(p, x+i, y+j);
+    ssd1306_fill_rect(p, (int32_t) x, (int32_t) y, (int32_t) width, (int32_t) height, SSD1306_FILL_SET);
 }
 
 void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
@@ -193,11 +444,37 @@ void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t wi
     ssd1306_draw_line(p, x+width, y, x+width, y+height);
 }
 
+// ors a vertical byte into the buffer with its top bit row at y, which may
+// straddle two pages or stick out of the panel
+static inline void ssd1306_or_column(ssd1306_t *p, int32_t x, int32_t y, uint8_t bits) {
+    if(!bits || x<0 || x>=p->width)
+        return;
+
+    const int32_t page=(y-(y&7))/8;
+    const uint8_t shift=y&7;
+    uint8_t *col=p->buffer+x;
+
+    if(page>=0 && page<p->pages)
+        col[page*p->width]|=bits<<shift;
+    if(shift && page+1>=0 && page+1<p->pages)
+        col[(page+1)*p->width]|=bits>>(8-shift);
+}
+
 void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
     if(c<font[3]||c>font[4])
         return;
 
     uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+
+    if(scale==1) {
+        // font columns are already vertical bytes: blit them whole
+        const uint8_t *glyph=font+5+(c-font[3])*font[1]*parts_per_line;
+        for(uint8_t w=0; w<font[1]; ++w)
+            for(uint32_t lp=0; lp<parts_per_line; ++lp)
+                ssd1306_or_column(p, (int32_t) x+w, (int32_t) y+(lp<<3), *glyph++);
+        return;
+    }
+
     for(uint8_t w=0; w<font[1]; ++w) { // width
         uint32_t pp=(c-font[3])*font[1]*parts_per_line+w*parts_per_line+5;
         for(uint32_t lp=0; lp<parts_per_line; ++lp) {
@@ -286,21 +563,157 @@ void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const
     }
 }
 
+void ssd1306_draw_image(ssd1306_t *p, const ssd1306_image_t *image, int32_t x, int32_t y) {
+    const int32_t col_start=x<0?-x:0;
+    const int32_t col_end=x+image->width>p->width?p->width-x:image->width;
+    if(col_start>=col_end)
+        return;
+
+    const size_t len=col_end-col_start;
+    const uint8_t shift=y&7;
+    const int32_t first_page=(y-shift)/8;
+    const uint8_t image_pages=(image->height+7)/8;
+
+    for(uint8_t ip=0; ip<image_pages; ++ip) {
+        const uint8_t *src=image->data+ip*image->width+col_start;
+        const int32_t page=first_page+ip;
+
+        if(page>=0 && page<p->pages) {
+            uint8_t *dst=p->buffer+page*p->width+x+col_start;
+            for(size_t i=0; i<len; ++i)
+                dst[i]|=src[i]<<shift;
+        }
+        if(shift && page+1>=0 && page+1<p->pages) {
+            uint8_t *dst=p->buffer+(page+1)*p->width+x+col_start;
+            for(size_t i=0; i<len; ++i)
+                dst[i]|=src[i]>>(8-shift);
+        }
+    }
+}
+
+void ssd1306_draw_sprite(ssd1306_t *p, const ssd1306_sprite_t *sprite, int32_t x, int32_t y) {
+    const int32_t col_start=x<0?-x:0;
+    const int32_t col_end=x+sprite->width>p->width?p->width-x:sprite->width;
+    if(col_start>=col_end)
+        return;
+
+    const size_t len=col_end-col_start;
+    const uint8_t shift=y&7;
+    const int32_t first_page=(y-shift)/8;
+    const uint8_t sprite_pages=(sprite->height+7)/8;
+
+    for(uint8_t sp=0; sp<sprite_pages; ++sp) {
+        const uint8_t *bits=sprite->bits+sp*sprite->width+col_start;
+        const uint8_t *mask=sprite->mask+sp*sprite->width+col_start;
+        const int32_t page=first_page+sp;
+
+        if(page>=0 && page<p->pages) {
+            uint8_t *dst=p->buffer+page*p->width+x+col_start;
+            for(size_t i=0; i<len; ++i)
+                dst[i]=(dst[i]&~(mask[i]<<shift))|(bits[i]<<shift);
+        }
+        if(shift && page+1>=0 && page+1<p->pages) {
+            uint8_t *dst=p->buffer+(page+1)*p->width+x+col_start;
+            for(size_t i=0; i<len; ++i)
+                dst[i]=(dst[i]&~(mask[i]>>(8-shift)))|(bits[i]>>(8-shift));
+        }
+    }
+}
+
 inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size) {
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
-void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
+// bytes needed to set a column/page window: control byte and six bytes of commands
+#define SSD1306_WINDOW_COST (1+SSD1306_WINDOW_COMMANDS)
+
+typedef struct {
+    ssd1306_transaction_t *transactions;
+    size_t count;
+    uint8_t *windows;
+} ssd1306_batch_t;
+
+static void ssd1306_batch_window(ssd1306_t *p, ssd1306_batch_t *b, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end) {
+    uint8_t *cmds=b->windows;
     if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
+        col_start+=32;
+        col_end+=32;
     }
+    cmds[0]=SET_COL_ADDR;
+    cmds[1]=col_start;
+    cmds[2]=col_end;
+    cmds[3]=SET_PAGE_ADDR;
+    cmds[4]=page_start;
+    cmds[5]=page_end;
+    b->windows+=SSD1306_WINDOW_COMMANDS;
+    b->transactions[b->count++]=(ssd1306_transaction_t) {cmds, SSD1306_WINDOW_COMMANDS, 0x00};
+}
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+// copies a span of the back buffer to the front buffer, which the transport sends it from
+static void ssd1306_batch_span(ssd1306_t *p, ssd1306_batch_t *b, size_t offset, size_t len) {
+    memcpy(p->front+offset, p->buffer+offset, len);
+    b->transactions[b->count++]=(ssd1306_transaction_t) {p->front+offset, len, 0x40};
+}
+
+inline void ssd1306_invalidate(ssd1306_t *p) {
+    p->front_valid=false;
+}
+
+inline bool ssd1306_busy(ssd1306_t *p) {
+    return p->transport.busy(p->transport.ctx);
+}
+
+void ssd1306_show(ssd1306_t *p) {
+    const uint32_t full_cost=SSD1306_WINDOW_COST+p->bufsize+1;
+    uint8_t first[p->pages], last[p->pages];
+    uint32_t cost=0;
+    uint8_t spans=0;
+    ssd1306_batch_t b= {p->transactions, 0, p->windows};
+
+    if(p->front_valid) {
+        for(uint8_t page=0; page<p->pages; ++page) {
+            const uint8_t *cur=p->buffer+page*p->width;
+            const uint8_t *old=p->front+page*p->width;
+            int32_t lo=0, hi=p->width-1;
+
+            while(lo<=hi && cur[lo]==old[lo])
+                ++lo;
+            while(hi>lo && cur[hi]==old[hi])
+                --hi;
+
+            first[page]=lo;
+            last[page]=hi;
+            if(lo<=hi) {
+                cost+=SSD1306_WINDOW_COST+(hi-lo+1)+1;
+                ++spans;
+            }
+        }
+    }
+
+    if(!p->front_valid || cost>=full_cost) {
+        ssd1306_batch_window(p, &b, 0, p->width-1, 0, p->pages-1);
+        ssd1306_batch_span(p, &b, 0, p->bufsize);
+        p->front_valid=true;
+        cost=full_cost;
+        spans=p->pages;
+    } else {
+        for(uint8_t page=0; page<p->pages; ++page) {
+            if(first[page]>last[page])
+                continue;
+
+            ssd1306_batch_window(p, &b, first[page], last[page], page, page);
+            ssd1306_batch_span(p, &b, page*p->width+first[page], last[page]-first[page]+1);
+        }
+    }
 
-    *(p->buffer-1)=0x40;
+    p->stats.last_transactions=0;
+    if(b.count)
+        ssd1306_submit(p, b.transactions, b.count);
 
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+    p->stats.frames++;
+    p->stats.last_sent=cost;
+    p->stats.last_saved=full_cost-cost;
+    p->stats.last_spans=spans;
+    p->stats.total_sent+=cost;
+    p->stats.total_saved+=full_cost-cost;
 }
@@ -56,6 +56,113 @@ typedef enum {
     SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+/**
+*	@brief monochrome image in the display's native page layout
+*
+*	data holds (height+7)/8 pages of width bytes each; every byte is a
+*	column of 8 rows, least significant bit on top. generated at build time
+*	by tools/pack_image.py.
+*/
+typedef struct {
+    uint8_t width;			/**< width in pixels */
+    uint8_t height;			/**< height in pixels */
+    const uint8_t *data;	/**< page-packed pixels */
+} ssd1306_image_t;
+
+/**
+*	@brief transparent sprite: a bitmap plane and a mask plane in page layout
+*
+*	both planes hold (height+7)/8 pages of width bytes. pixels set in mask
+*	are replaced by the matching pixels of bits, the others are left as
+*	they are. a mask equal to bits draws the sprite like the text functions
+*	do (or).
+*/
+typedef struct {
+    uint8_t width;			/**< width in pixels */
+    uint8_t height;			/**< height in pixels */
+    const uint8_t *bits;	/**< pixels to turn on */
+    const uint8_t *mask;	/**< pixels owned by the sprite */
+} ssd1306_sprite_t;
+
+/**
+*	@brief how ssd1306_fill_rect combines the rectangle with the buffer
+*/
+typedef enum {
+    SSD1306_FILL_SET,		/**< turn pixels on */
+    SSD1306_FILL_CLEAR,		/**< turn pixels off */
+    SSD1306_FILL_INVERT		/**< flip pixels (xor) */
+} ssd1306_fill_mode_t;
+
+/**
+*	@brief bus statistics, updated by every call that talks to the display
+*
+*	byte counts include the control byte and the addressing commands, but
+*	not the i2c address byte.
+*/
+typedef struct {
+    uint32_t last_transactions;	/**< i2c transactions issued by the last driver call */
+    uint64_t total_transactions;	/**< i2c transactions issued since initialization */
+    uint32_t frames;		/**< number of flushes performed */
+    uint32_t last_sent;		/**< bytes sent by the last flush */
+    uint32_t last_saved;	/**< bytes the last flush saved compared to a full refresh */
+    uint8_t last_spans;		/**< dirty page spans sent by the last flush (0 if nothing changed) */
+    uint64_t total_sent;	/**< bytes sent since initialization */
+    uint64_t total_saved;	/**< bytes saved since initialization */
+} ssd1306_flush_stats_t;
+
+/**
+*	@brief one i2c write transaction: a control byte followed by len bytes
+*
+*	the bytes are not copied into the transaction: data points at where they
+*	live, the front buffer for display data.
+*/
+typedef struct {
+    const uint8_t *data;	/**< bytes sent after the control byte */
+    uint16_t len;			/**< number of bytes at data */
+    uint8_t control;		/**< control byte: 0x00 for commands, 0x40 for display data */
+} ssd1306_transaction_t;
+
+/**
+*	@brief bus transport used by the driver
+*
+*	every transfer is handed over as a batch of i2c write transactions.
+*	submit may return before the batch is on the bus, but must not read the
+*	transactions or their bytes after returning: the driver rewrites both
+*	for the next flush. if a previous batch is still being sent, submit
+*	waits for it first.
+*/
+typedef struct {
+    void (*submit)(void *ctx, uint8_t address, const ssd1306_transaction_t *transactions, size_t count); /**< starts sending a batch */
+    bool (*busy)(void *ctx);	/**< whether a batch is still being sent */
+    void *ctx;					/**< transport state passed to the callbacks */
+} ssd1306_transport_t;
+
+/**
+*	@brief size in bytes, control bytes included, of the largest batch the driver submits for a display
+*
+*	a full refresh: one command transaction setting the column and page
+*	window (control byte and six bytes), then the control byte and the
+*	whole buffer.
+*/
+#define SSD1306_BATCH_MAX_BYTES(width, height) (1+6+((height)/8)*(width)+1)
+
+/**
+*	@brief maximum number of bytes in a command list
+*/
+#define SSD1306_CMDLIST_MAX 32
+
+/**
+*	@brief list of commands sent to the display in a single transaction
+*
+*	build it with ssd1306_cmdlist_init and ssd1306_cmdlist_add, then send it
+*	with ssd1306_cmdlist_send. all bytes go after one 0x00 control byte, so
+*	the whole list costs one address and one stop on the bus.
+*/
+typedef struct {
+    uint8_t data[1+SSD1306_CMDLIST_MAX];	/**< control byte followed by the commands */
+    uint8_t len;	/**< number of commands in data */
+} ssd1306_cmdlist_t;
+
 /**
 *	@brief holds the configuration
 */
@@ -66,8 +173,15 @@ typedef struct {
     uint8_t address; 	/**< i2c address of display*/
     i2c_inst_t *i2c_i; 	/**< i2c connection instance */
     bool external_vcc; 	/**< whether display uses external vcc */ 
-    uint8_t *buffer;	/**< display buffer */
+    uint8_t *buffer;	/**< display buffer (back buffer, drawn into) */
     size_t bufsize;		/**< buffer size */
+    uint8_t *front;		/**< front buffer, the last frame handed to the transport */
+    bool front_valid;	/**< whether front matches the display RAM */
+    uint8_t *windows;	/**< column/page window commands of a flush, six bytes per page */
+    ssd1306_transaction_t *transactions; /**< transactions of a flush, two per page */
+    uint8_t *staging;	/**< control byte and bytes of one transaction, for the blocking i2c transport only */
+    ssd1306_transport_t transport; /**< bus transport, blocking i2c if left empty before init */
+    ssd1306_flush_stats_t stats; /**< bus and flush statistics */
 } ssd1306_t;
 
 /**
@@ -78,6 +192,9 @@ typedef struct {
 *	@param[in] height : heigth of display
 *	@param[in] address : i2c address of display
 *	@param[in] i2c_instance : instance of i2c connection
+*
+*	if p->transport.submit is set before calling, that transport is used,
+*	otherwise transfers are done with i2c_write_blocking on i2c_instance.
 *	
 * 	@return bool.
 *	@retval true for Success
@@ -93,6 +210,42 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 */
 void ssd1306_deinit(ssd1306_t *p);
 
+/**
+*	@brief start an empty command list
+*
+*	@param[out] l : command list
+*/
+void ssd1306_cmdlist_init(ssd1306_cmdlist_t *l);
+
+/**
+*	@brief append a command (or command argument) to a list
+*
+*	@param[in] l : command list
+*	@param[in] cmd : byte to append
+*
+*	@return bool.
+*	@retval true if the byte was appended
+*	@retval false if the list is full
+*/
+bool ssd1306_cmdlist_add(ssd1306_cmdlist_t *l, uint8_t cmd);
+
+/**
+*	@brief send a command list in one i2c transaction
+*
+*	@param[in] p : instance of display
+*	@param[in] l : command list
+*/
+void ssd1306_cmdlist_send(ssd1306_t *p, const ssd1306_cmdlist_t *l);
+
+/**
+*	@brief i2c transactions issued by the last call that talked to the display
+*
+*	@param[in] p : instance of display
+*
+*	@return number of transactions
+*/
+uint32_t ssd1306_last_transactions(ssd1306_t *p);
+
 /**
 *	@brief turn off display
 *
@@ -130,11 +283,37 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 /**
 	@brief display buffer, should be called on change
 
+	only the columns that changed since the last call are sent: for every page
+	the first and last differing column are found and a column/page window is
+	set for that span. falls back to a full refresh when that is cheaper.
+
+	the changed spans are copied to the front buffer and handed to the
+	transport straight from there, so drawing into the buffer can continue
+	while they are sent. only waits if the previous flush is still on the
+	bus.
+
 	@param[in] p : instance of display
 
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief forget what the display holds, next ssd1306_show sends the whole buffer
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_invalidate(ssd1306_t *p);
+
+/**
+	@brief check whether a flush is still being sent
+
+	@param[in] p : instance of display
+
+	@return true while the transport is busy
+*/
+bool ssd1306_busy(ssd1306_t *p);
+
 /**
 	@brief clear display buffer
 
@@ -172,6 +351,23 @@ void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y);
 */
 void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
 
+/**
+	@brief fill a rectangle on buffer
+
+	the rectangle is clipped to the display once, then filled a page at a
+	time: partial top and bottom pages use a bit mask, full pages are set
+	or cleared a whole byte (or word, when inverting) at a time.
+	coordinates may be negative.
+
+	@param[in] p : instance of display
+	@param[in] x : x position of starting point
+	@param[in] y : y position of starting point
+	@param[in] width : width of rectangle
+	@param[in] height : height of rectangle
+	@param[in] mode : set, clear or invert the pixels
+*/
+void ssd1306_fill_rect(ssd1306_t *p, int32_t x, int32_t y, int32_t width, int32_t height, ssd1306_fill_mode_t mode);
+
 /**
 	@brief clear square at given position with given size
 
@@ -216,6 +412,34 @@ void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t wi
 */
 void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const long size, uint32_t x_offset, uint32_t y_offset);
 
+/**
+	@brief draw page-packed image
+
+	lit pixels of the image are ored into the buffer a page row at a time;
+	when y is not a multiple of 8 every byte is split over two pages with a
+	shift. coordinates may be negative.
+
+	@param[in] p : instance of display
+	@param[in] image : image to draw
+	@param[in] x : x position of the top left corner
+	@param[in] y : y position of the top left corner
+*/
+void ssd1306_draw_image(ssd1306_t *p, const ssd1306_image_t *image, int32_t x, int32_t y);
+
+/**
+	@brief draw sprite with its mask
+
+	every byte is combined as fb = (fb & ~mask) | bits; when y is not a
+	multiple of 8 the byte is split over two pages with two shifted writes.
+	coordinates may be negative.
+
+	@param[in] p : instance of display
+	@param[in] sprite : sprite to draw
+	@param[in] x : x position of the top left corner
+	@param[in] y : y position of the top left corner
+*/
+void ssd1306_draw_sprite(ssd1306_t *p, const ssd1306_sprite_t *sprite, int32_t x, int32_t y);
+
 /**
 	@brief draw monochrome bitmap
 
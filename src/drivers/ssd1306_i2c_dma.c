@@ -0,0 +1,165 @@
+/**
+ * @file ssd1306_i2c_dma.c
+ * @brief Implementation of the DMA driven I2C transport.
+ *
+ * The RP2040 I2C block takes 16-bit words in IC_DATA_CMD: the data byte plus
+ * control bits. Every batch is encoded into such words straight from the
+ * bytes its transactions point at (the driver's front buffer), with the STOP
+ * bit set on the last byte of each transaction, and the whole batch is
+ * pushed by a single DMA transfer paced by the I2C TX DREQ. After a STOP the
+ * peripheral starts the next transaction on its own as soon as the FIFO has
+ * data. A batch larger than the stream goes in stream-sized pieces: until a
+ * STOP is sent the master holds the bus while the FIFO is empty.
+ */
+
+#include "ssd1306_i2c_dma.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "hardware/dma.h"
+
+/**
+ * @brief Reports an aborted transfer (address not acknowledged) once.
+ *
+ * The abort stops the DMA, which would otherwise wait on a flushed FIFO.
+ *
+ * @param dma Transport state.
+ */
+static void ssd1306_i2c_dma_check_abort(ssd1306_i2c_dma_t *dma)
+{
+    i2c_hw_t *hw = i2c_get_hw(dma->i2c);
+
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+    {
+        dma_channel_abort(dma->dmaChannel);
+        (void)hw->clr_tx_abrt;
+        dma->errors++;
+        printf("[ssd1306_i2c_dma] transfer aborted!\n");
+    }
+}
+
+/**
+ * @brief Checks whether the last batch is still being sent.
+ *
+ * The transfer is over once the DMA channel has finished, the TX FIFO is
+ * empty and the master is idle.
+ *
+ * @param ctx Transport state.
+ * @return true while the bus is still busy with the last batch.
+ */
+static bool ssd1306_i2c_dma_busy(void *ctx)
+{
+    ssd1306_i2c_dma_t *dma = ctx;
+    i2c_hw_t *hw = i2c_get_hw(dma->i2c);
+
+    ssd1306_i2c_dma_check_abort(dma);
+    if (dma_channel_is_busy(dma->dmaChannel))
+        return true;
+
+    return !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+}
+
+/**
+ * @brief Sends the words staged so far and waits until the DMA took them.
+ * @param dma Transport state.
+ * @param word End of the staged words.
+ * @return Start of the stream, free again.
+ */
+static uint16_t *ssd1306_i2c_dma_send_piece(ssd1306_i2c_dma_t *dma, uint16_t *word)
+{
+    dma_channel_transfer_from_buffer_now(dma->dmaChannel, dma->stream, word - dma->stream);
+    while (dma_channel_is_busy(dma->dmaChannel))
+        ssd1306_i2c_dma_check_abort(dma);
+    return dma->stream;
+}
+
+/**
+ * @brief Encodes bytes as data words, sending a piece whenever the stream is full.
+ * @param dma Transport state.
+ * @param word Next free word of the stream.
+ * @param src Bytes to encode.
+ * @param len Number of bytes.
+ * @return Next free word of the stream.
+ */
+static uint16_t *ssd1306_i2c_dma_encode(ssd1306_i2c_dma_t *dma, uint16_t *word, const uint8_t *src, size_t len)
+{
+    uint16_t *end = dma->stream + dma->capacity;
+
+    while (len > 0)
+    {
+        if (word == end)
+            word = ssd1306_i2c_dma_send_piece(dma, word);
+
+        size_t n = MIN(len, (size_t)(end - word));
+        for (size_t j = 0; j < n; j++)
+            word[j] = src[j];
+        word += n;
+        src += n;
+        len -= n;
+    }
+    return word;
+}
+
+/**
+ * @brief Encodes a batch and starts the DMA transfer.
+ *
+ * Waits for the previous batch first. Only returns early for the last
+ * piece of a batch larger than the stream.
+ */
+static void ssd1306_i2c_dma_submit(void *ctx, uint8_t address, const ssd1306_transaction_t *transactions, size_t count)
+{
+    ssd1306_i2c_dma_t *dma = ctx;
+    i2c_hw_t *hw = i2c_get_hw(dma->i2c);
+
+    while (ssd1306_i2c_dma_busy(dma))
+        tight_loop_contents();
+
+    if (address != dma->address)
+    {
+        hw->enable = 0;
+        hw->tar = address;
+        hw->enable = 1;
+        dma->address = address;
+    }
+
+    uint16_t *word = dma->stream;
+    for (size_t i = 0; i < count; i++)
+    {
+        word = ssd1306_i2c_dma_encode(dma, word, &transactions[i].control, 1);
+        word = ssd1306_i2c_dma_encode(dma, word, transactions[i].data, transactions[i].len);
+        word[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    }
+
+    dma_channel_transfer_from_buffer_now(dma->dmaChannel, dma->stream, word - dma->stream);
+}
+
+bool ssd1306_i2c_dma_init(ssd1306_i2c_dma_t *dma, i2c_inst_t *i2c, size_t capacity)
+{
+    dma->stream = malloc(capacity * sizeof(uint16_t));
+    if (dma->stream == NULL)
+        return false;
+
+    dma->i2c = i2c;
+    dma->capacity = capacity;
+    dma->address = 0xFF; // Not a valid 7-bit address, forces the first submit to set it
+    dma->errors = 0;
+    dma->dmaChannel = dma_claim_unused_channel(true);
+
+    dma_channel_config config = dma_channel_get_default_config(dma->dmaChannel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(i2c, true));
+    dma_channel_configure(dma->dmaChannel, &config, &i2c_get_hw(i2c)->data_cmd, dma->stream, 0, false);
+
+    return true;
+}
+
+ssd1306_transport_t ssd1306_i2c_dma_transport(ssd1306_i2c_dma_t *dma)
+{
+    ssd1306_transport_t transport = {
+        .submit = ssd1306_i2c_dma_submit,
+        .busy = ssd1306_i2c_dma_busy,
+        .ctx = dma,
+    };
+    return transport;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file ssd1306_i2c_dma.h
+ * @brief DMA driven I2C transport for the SSD1306 driver.
+ *
+ * Streams the batches produced by the SSD1306 driver to the I2C peripheral
+ * with a DMA channel, so the CPU is free while a frame is being sent.
+ */
+
+#ifndef SSD1306_I2C_DMA_H
+#define SSD1306_I2C_DMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+
+/**
+ * @brief State of the DMA transport.
+ */
+typedef struct
+{
+    i2c_inst_t *i2c;   /**< I2C instance the display is connected to. */
+    uint dmaChannel;   /**< DMA channel feeding the I2C TX FIFO. */
+    uint16_t *stream;  /**< Data/command words written to IC_DATA_CMD. */
+    size_t capacity;   /**< Size of the stream, in bytes of payload; larger batches go in pieces. */
+    uint8_t address;   /**< Target address currently set on the peripheral. */
+    uint32_t errors;   /**< Number of aborted transfers. */
+} ssd1306_i2c_dma_t;
+
+/**
+ * @brief Claims a DMA channel and allocates the stream buffer.
+ * @param dma Transport state to initialize.
+ * @param i2c Initialized I2C instance.
+ * @param capacity Largest batch to send in one piece, in bytes (see SSD1306_BATCH_MAX_BYTES).
+ * @return true on success, false if the stream buffer could not be allocated.
+ */
+bool ssd1306_i2c_dma_init(ssd1306_i2c_dma_t *dma, i2c_inst_t *i2c, size_t capacity);
+
+/**
+ * @brief Returns the transport to plug into ssd1306_t before ssd1306_init.
+ * @param dma Initialized transport state.
+ * @return The transport callbacks bound to dma.
+ */
+ssd1306_transport_t ssd1306_i2c_dma_transport(ssd1306_i2c_dma_t *dma);
+
+#endif // SSD1306_I2C_DMA_H
@@ -11,7 +11,9 @@
 #include <stdlib.h>
 #include "initialize.h"
 #include <math.h>
+#include <string.h>
 #include "display.h"
+#include "random.h"
 
 /**
  * Degrees to radians conversion constant: (PI / 180)
@@ -19,9 +21,41 @@
 #define DEG2RAD 0.0174532925
 
 /**
- * @brief Global variable for the asteroids array.
+ * @brief Width and height of the asteroid sprite.
+ *
+ * The corners of the rotating 8x8 square reach 6 pixels from the center.
+ */
+#define ASTEROID_SPRITE_SIZE 12
+
+/**
+ * @brief Position of the asteroid center inside its sprite.
+ */
+#define ASTEROID_SPRITE_ORIGIN 6
+
+/**
+ * @brief Bytes in each plane of the asteroid sprite.
+ */
+#define ASTEROID_SPRITE_BYTES (ASTEROID_SPRITE_SIZE * ((ASTEROID_SPRITE_SIZE + 7) / 8))
+
+/**
+ * @brief Global variable for the asteroids.
+ */
+AsteroidStore asteroids;
+
+/**
+ * @brief Bitmap planes of the pre-rendered rotation frames.
+ */
+static uint8_t asteroidSpriteBits[ASTEROID_ROTATIONS][ASTEROID_SPRITE_BYTES];
+
+/**
+ * @brief Mask planes of the pre-rendered rotation frames.
+ */
+static uint8_t asteroidSpriteMasks[ASTEROID_ROTATIONS][ASTEROID_SPRITE_BYTES];
+
+/**
+ * @brief Rotation cache: one sprite per angle, indexed by angle / ASTEROID_ROTATION_STEP.
  */
-Asteroid asteroids[MAX_ASTEROIDS];
+static ssd1306_sprite_t asteroidSprites[ASTEROID_ROTATIONS];
 
 /**
  * @brief Initializes the asteroids.
@@ -30,17 +64,19 @@ Asteroid asteroids[MAX_ASTEROIDS];
  */
 void initAsteroids()
 {
+    asteroidPoolInit(&asteroids.pool);
     for (int i = 0; i < MAX_ASTEROIDS; i++)
     {
-        asteroids[i].box.x = SCREEN_WIDTH + (rand() % 100);    // initial x position offscreen
-        asteroids[i].box.y = 8 + rand() % (SCREEN_HEIGHT - 8); // random y position
-        asteroids[i].box.w = 8;                                // Asteroid width
-        asteroids[i].box.h = 8;                                // Asteroid height
-        asteroids[i].dx = -1;                                  // Velocity in x
-        asteroids[i].dy = 0;                                   // Velocity in y
-        asteroids[i].angle = rand() % 360;                     // Random angle
-        asteroids[i].active = (i < 3);                         // Ativar os 3 primeiros asteroides.
+        asteroids.x[i] = SCREEN_WIDTH + randomBelow(RANDOM_SPAWNS, 100);   // initial x position offscreen
+        asteroids.y[i] = randomRange(RANDOM_SPAWNS, 8, SCREEN_HEIGHT - 1); // random y position
+        asteroids.dx[i] = -1;                                              // Velocity in x
+        asteroids.dy[i] = 0;                                               // Velocity in y
+        asteroids.rotation[i] = randomBelow(RANDOM_SPAWNS, ASTEROID_ROTATIONS); // Random angle
     }
+
+    // Ativar os 3 primeiros asteroides (an empty pool hands out slots in order).
+    for (int i = 0; i < 3; i++)
+        asteroidPoolSpawn(&asteroids.pool);
 }
 
 /**
@@ -50,92 +86,135 @@ void initAsteroids()
  *
  * @param asteroidsSpeed Speed multiplier for the asteroids' movement.
  */
-void moveAsteroids(float asteroidsSpeed)
+void moveAsteroids(fixed_t asteroidsSpeed)
 {
-    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    ENTITY_POOL_FOR_EACH(i, &asteroids.pool)
     {
-        if (asteroids[i].active)
-        {
-            asteroids[i].box.x += asteroids[i].dx * asteroidsSpeed;
-            asteroids[i].box.y += asteroids[i].dy * asteroidsSpeed;
-
-            asteroids[i].angle += 3;
-            asteroids[i].angle = asteroids[i].angle % 360;
-
-            // Check if asteroid has left the screen and reposition it
-            if (asteroids[i].box.x < asteroids[i].box.w * -1)
-                asteroids[i].active = 0; // Deactivate asteroid when it leaves the screen
-            if (asteroids[i].box.y < 0)
-                asteroids[i].box.y = SCREEN_HEIGHT - 1;
-            if (asteroids[i].box.y >= SCREEN_HEIGHT)
-                asteroids[i].box.y = 0;
-        }
+        asteroids.x[i] = fxToInt(fxFromInt(asteroids.x[i]) + asteroids.dx[i] * asteroidsSpeed);
+        asteroids.y[i] = fxToInt(fxFromInt(asteroids.y[i]) + asteroids.dy[i] * asteroidsSpeed);
+
+        asteroids.rotation[i] = asteroids.rotation[i] + 1 < ASTEROID_ROTATIONS ? asteroids.rotation[i] + 1 : 0;
+
+        // Check if asteroid has left the screen and reposition it
+        if (asteroids.x[i] < -ASTEROID_SIZE)
+            asteroidPoolDespawn(&asteroids.pool, i); // Deactivate asteroid when it leaves the screen
+        if (asteroids.y[i] < 0)
+            asteroids.y[i] = SCREEN_HEIGHT - 1;
+        if (asteroids.y[i] >= SCREEN_HEIGHT)
+            asteroids.y[i] = 0;
+    }
+}
+
+/**
+ * @brief Renders the sprite of an asteroid at a given angle.
+ *
+ * The asteroid is a rotating square behind a fixed square with a center
+ * pixel. The fixed square hides what is behind it, so its whole area goes
+ * into the mask along with every lit pixel.
+ *
+ * @param angle Rotation angle (in degrees).
+ * @param halfW Half of the asteroid width.
+ * @param halfH Half of the asteroid height.
+ * @param bits Bitmap plane, ASTEROID_SPRITE_BYTES long.
+ * @param mask Mask plane, ASTEROID_SPRITE_BYTES long.
+ */
+static void renderAsteroidSprite(int angle, int halfW, int halfH, uint8_t *bits, uint8_t *mask)
+{
+    ssd1306_t canvas = {
+        .width = ASTEROID_SPRITE_SIZE,
+        .height = ASTEROID_SPRITE_SIZE,
+        .pages = (ASTEROID_SPRITE_SIZE + 7) / 8,
+        .bufsize = ASTEROID_SPRITE_BYTES,
+        .buffer = bits,
+    };
+    memset(bits, 0, ASTEROID_SPRITE_BYTES);
+
+    int _x = ASTEROID_SPRITE_ORIGIN;
+    int _y = ASTEROID_SPRITE_ORIGIN;
+    int _w = halfW;
+    int _h = halfH;
+
+    // Coordinates of the rotating square
+    int _x1 = _x + cos(angle * DEG2RAD) * _w - sin(angle * DEG2RAD) * _h;
+    int _y1 = _y + sin(angle * DEG2RAD) * _w + cos(angle * DEG2RAD) * _h;
+    int _x2 = _x - cos(angle * DEG2RAD) * _w - sin(angle * DEG2RAD) * _h;
+    int _y2 = _y - sin(angle * DEG2RAD) * _w + cos(angle * DEG2RAD) * _h;
+    int _x3 = _x - cos(angle * DEG2RAD) * _w + sin(angle * DEG2RAD) * _h;
+    int _y3 = _y - sin(angle * DEG2RAD) * _w - cos(angle * DEG2RAD) * _h;
+    int _x4 = _x + cos(angle * DEG2RAD) * _w + sin(angle * DEG2RAD) * _h;
+    int _y4 = _y + sin(angle * DEG2RAD) * _w - cos(angle * DEG2RAD) * _h;
+
+    // Drawing the rotating square
+    ssd1306_draw_line(&canvas, _x1, _y1, _x2, _y2);
+    ssd1306_draw_line(&canvas, _x2, _y2, _x3, _y3);
+    ssd1306_draw_line(&canvas, _x3, _y3, _x4, _y4);
+    ssd1306_draw_line(&canvas, _x4, _y4, _x1, _y1);
+
+    // Fixed square in front of the asteroid
+    ssd1306_clear_square(&canvas, _x - _w, _y - _h, _w * 2, _h * 2);
+    ssd1306_draw_empty_square(&canvas, _x - _w, _y - _h, _w * 2, _h * 2);
+
+    // Central point of the asteroid
+    ssd1306_draw_pixel(&canvas, _x, _y);
+
+    // Mask: the inside of the fixed square plus every lit pixel
+    canvas.buffer = mask;
+    memset(mask, 0, ASTEROID_SPRITE_BYTES);
+    ssd1306_fill_rect(&canvas, _x - _w, _y - _h, _w * 2, _h * 2, SSD1306_FILL_SET);
+    for (int i = 0; i < ASTEROID_SPRITE_BYTES; i++)
+    {
+        mask[i] |= bits[i];
+    }
+}
+
+/**
+ * @brief Fills the asteroid rotation cache.
+ *
+ * Renders the sprite of every angle an asteroid can have, so drawing is a
+ * table lookup and a blit. Must run once before the first drawAsteroids.
+ */
+void initAsteroidSprites()
+{
+    for (int i = 0; i < ASTEROID_ROTATIONS; i++)
+    {
+        renderAsteroidSprite(i * ASTEROID_ROTATION_STEP, ASTEROID_SIZE / 2, ASTEROID_SIZE / 2,
+                             asteroidSpriteBits[i], asteroidSpriteMasks[i]);
+
+        asteroidSprites[i].width = ASTEROID_SPRITE_SIZE;
+        asteroidSprites[i].height = ASTEROID_SPRITE_SIZE;
+        asteroidSprites[i].bits = asteroidSpriteBits[i];
+        asteroidSprites[i].mask = asteroidSpriteMasks[i];
     }
 }
 
 /**
  * @brief Draws the asteroids.
  *
- * Draws each active asteroid as a rotating square and a center pixel.
+ * Draws each active asteroid as a rotating square and a center pixel,
+ * blitting its frame from the rotation cache.
+ *
+ * @param store Asteroids to draw (the global store or a frame snapshot).
  */
-void drawAsteroids()
+void drawAsteroids(const AsteroidStore *store)
 {
-    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    ENTITY_POOL_FOR_EACH(i, &store->pool)
     {
-        if (asteroids[i].active)
-        {
-
-            int _x = asteroids[i].box.x;
-            int _y = asteroids[i].box.y;
-            int _w = asteroids[i].box.w / 2; // Using half of the width to centralize
-            int _h = asteroids[i].box.h / 2; // Using half of the height to centralize
-
-            int ang = asteroids[i].angle;
-
-            // Coordinates of the rotating square
-            int _x1 = _x + cos(ang * DEG2RAD) * _w - sin(ang * DEG2RAD) * _h;
-            int _y1 = _y + sin(ang * DEG2RAD) * _w + cos(ang * DEG2RAD) * _h;
-            int _x2 = _x - cos(ang * DEG2RAD) * _w - sin(ang * DEG2RAD) * _h;
-            int _y2 = _y - sin(ang * DEG2RAD) * _w + cos(ang * DEG2RAD) * _h;
-            int _x3 = _x - cos(ang * DEG2RAD) * _w + sin(ang * DEG2RAD) * _h;
-            int _y3 = _y - sin(ang * DEG2RAD) * _w - cos(ang * DEG2RAD) * _h;
-            int _x4 = _x + cos(ang * DEG2RAD) * _w + sin(ang * DEG2RAD) * _h;
-            int _y4 = _y + sin(ang * DEG2RAD) * _w - cos(ang * DEG2RAD) * _h;
-
-            // Drawing the rotating square
-            ssd1306_draw_line(&display, _x1, _y1, _x2, _y2);
-            ssd1306_draw_line(&display, _x2, _y2, _x3, _y3);
-            ssd1306_draw_line(&display, _x3, _y3, _x4, _y4);
-            ssd1306_draw_line(&display, _x4, _y4, _x1, _y1);
-
-            // Fixed square in front of the asteroid
-            ssd1306_clear_square(&display, _x - _w, _y - _h, _w * 2, _h * 2);
-            ssd1306_draw_empty_square(&display, _x - _w, _y - _h, _w * 2, _h * 2);
-
-            // Central point of the asteroid
-            ssd1306_draw_pixel(&display, _x, _y);
-        }
+        ssd1306_draw_sprite(&display, &asteroidSprites[store->rotation[i]],
+                            store->x[i] - ASTEROID_SPRITE_ORIGIN,
+                            store->y[i] - ASTEROID_SPRITE_ORIGIN);
     }
 }
 
 /**
  * @brief Get number of active asteroids.
  *
- * Iterate for all possible asteroirds and verify if it's active.
+ * The pool keeps the count, so this is a read.
  *
  * @return Amount of active asteroids
  */
 int getAsteroidsActive()
 {
-    int count = 0;
-    for (int i = 0; i < MAX_ASTEROIDS; i++)
-    {
-        if (asteroids[i].active)
-        {
-            count++;
-        }
-    }
-    return count;
+    return asteroids.pool.count;
 }
 
 /**
@@ -145,19 +224,13 @@ int getAsteroidsActive()
  */
 void spawnAsteroid()
 {
-    for (int i = 0; i < MAX_ASTEROIDS; i++)
-    {
-        if (!asteroids[i].active)
-        {
-            asteroids[i].box.x = SCREEN_WIDTH + 32;
-            asteroids[i].box.y = 8 + rand() % (SCREEN_HEIGHT - 8);
-            asteroids[i].box.w = 8;
-            asteroids[i].box.h = 8;
-            asteroids[i].dx = -1;
-            asteroids[i].dy = 0;
-            asteroids[i].active = 1;
-            asteroids[i].angle = rand() % 360;
-            break;
-        }
-    }
+    int i = asteroidPoolSpawn(&asteroids.pool);
+    if (i < 0)
+        return;
+
+    asteroids.x[i] = SCREEN_WIDTH + 32;
+    asteroids.y[i] = randomRange(RANDOM_SPAWNS, 8, SCREEN_HEIGHT - 1);
+    asteroids.dx[i] = -1;
+    asteroids.dy[i] = 0;
+    asteroids.rotation[i] = randomBelow(RANDOM_SPAWNS, ASTEROID_ROTATIONS);
 }
\ No newline at end of file
@@ -11,23 +11,60 @@
 
 #include <stdint.h>
 #include "boundingBox.h"
+#include "entityPool.h"
+#include "fixedMath.h"
+
+/** @brief Most asteroids alive at once. */
+#ifndef MAX_ASTEROIDS
+#define MAX_ASTEROIDS 10
+#endif
+
+/** @brief Width and height of an asteroid */
+#define ASTEROID_SIZE 8
+/** @brief Degrees an asteroid rotates on each update */
+#define ASTEROID_ROTATION_STEP 3
+/** @brief Number of distinct rotation angles (frames in the rotation cache) */
+#define ASTEROID_ROTATIONS (360 / ASTEROID_ROTATION_STEP)
+
+/** @brief Pool of asteroid slots. */
+ENTITY_POOL(AsteroidPool, asteroidPool, MAX_ASTEROIDS)
 
 /**
- * @brief Asteroid structure
+ * @brief Asteroid store: one array per field, indexed by slot.
+ *
+ * Every asteroid is ASTEROID_SIZE wide and high, so the size isn't stored.
  */
 typedef struct
 {
-    BoundingBox box; /**< Bounding box for collision detection. */
-    int dx;          /**< Horizontal velocity */
-    int dy;          /**< Vertical velocity. */
-    int active;      /**< Is active asteroid or not? */
-    int angle;       /**< Rotation angle (in degrees). */
-} Asteroid;
+    AsteroidPool pool;               /**< Which slots are live. */
+    int16_t x[MAX_ASTEROIDS];        /**< Center, horizontal. */
+    int16_t y[MAX_ASTEROIDS];        /**< Center, vertical. */
+    int8_t dx[MAX_ASTEROIDS];        /**< Horizontal velocity. */
+    int8_t dy[MAX_ASTEROIDS];        /**< Vertical velocity. */
+    uint8_t rotation[MAX_ASTEROIDS]; /**< Frame of the rotation cache (angle / ASTEROID_ROTATION_STEP). */
+} AsteroidStore;
+
+/**
+ * @brief Bounding box of an asteroid, for collision detection.
+ * @param store Asteroid store.
+ * @param i Index of the asteroid.
+ * @return Box centered on the asteroid.
+ */
+static inline BoundingBox asteroidBox(const AsteroidStore *store, int i)
+{
+    BoundingBox box = {store->x[i], store->y[i], ASTEROID_SIZE, ASTEROID_SIZE};
+    return box;
+}
 
 /**
  * @brief Asteroid functions
  */
 
+/**
+ * @brief Fills the asteroid rotation cache.
+ */
+void initAsteroidSprites();
+
 /**
  *  @brief Initializes the asteroids.
  */
@@ -37,12 +74,13 @@ void initAsteroids();
  * @brief Moves the asteroids.
  * @param asteroidsSpeed Speed of the asteroid movement.
  */
-void moveAsteroids(float asteroidsSpeed);
+void moveAsteroids(fixed_t asteroidsSpeed);
 
 /**
  * @brief Draws the asteroids.
+ * @param store Asteroids to draw.
  */
-void drawAsteroids();
+void drawAsteroids(const AsteroidStore *store);
 
 /**
  * @brief Spawns a new asteroid.
@@ -55,8 +93,7 @@ void spawnAsteroid();
  */
 int getAsteroidsActive();
 
-/** @brief Global variable for the asteroids array. */
-#define MAX_ASTEROIDS 10
-extern Asteroid asteroids[MAX_ASTEROIDS];
+/** @brief Global variable for the asteroids. */
+extern AsteroidStore asteroids;
 
 #endif // ASTEROIDS_H
\ No newline at end of file
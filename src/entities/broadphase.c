@@ -0,0 +1,152 @@
+/**
+ * @file broadphase.c
+ * @brief Implementation of the uniform grid broadphase.
+ */
+
+#include "broadphase.h"
+
+#include <string.h>
+
+/**
+ * @brief Clamps a coordinate to a cell column or row.
+ * @param position Center of the collider along the axis.
+ * @param cells Cells along the axis.
+ * @return Cell along the axis.
+ */
+static inline int cellAlong(int position, int cells)
+{
+    int cell = position / BROADPHASE_CELL_SIZE;
+    if (position < 0)
+        return 0;
+    return cell < cells ? cell : cells - 1;
+}
+
+void broadphaseInit(Broadphase *broadphase, Collider *colliders, uint16_t *order, uint8_t *cells, int capacity)
+{
+    broadphase->colliders = colliders;
+    broadphase->order = order;
+    broadphase->cells = cells;
+    broadphase->capacity = capacity;
+    broadphase->count = 0;
+}
+
+void broadphaseClear(Broadphase *broadphase)
+{
+    broadphase->count = 0;
+}
+
+bool broadphaseAdd(Broadphase *broadphase, BoundingBox box, uint8_t layer, uint8_t mask, uint16_t id)
+{
+    if (broadphase->count >= broadphase->capacity)
+        return false;
+
+    int index = broadphase->count++;
+    Collider *collider = &broadphase->colliders[index];
+    collider->box = box;
+    collider->id = id;
+    collider->layer = layer;
+    collider->mask = mask;
+    broadphase->cells[index] = cellAlong(box.y, BROADPHASE_ROWS) * BROADPHASE_COLUMNS +
+                               cellAlong(box.x, BROADPHASE_COLUMNS);
+    return true;
+}
+
+/**
+ * @brief Sorts the colliders by cell with a counting sort.
+ * @param broadphase Broadphase to sort.
+ */
+static void sortByCell(Broadphase *broadphase)
+{
+    uint16_t *start = broadphase->cellStart;
+    memset(start, 0, sizeof(broadphase->cellStart));
+
+    for (int i = 0; i < broadphase->count; i++)
+        start[broadphase->cells[i] + 1]++;
+    for (int cell = 0; cell < BROADPHASE_CELLS; cell++)
+        start[cell + 1] += start[cell];
+
+    // Scatter using the starts as cursors, then shift them back into place
+    for (int i = 0; i < broadphase->count; i++)
+        broadphase->order[start[broadphase->cells[i]]++] = i;
+    for (int cell = BROADPHASE_CELLS; cell > 0; cell--)
+        start[cell] = start[cell - 1];
+    start[0] = 0;
+}
+
+/**
+ * @brief Tests two colliders and records them if they overlap.
+ * @return 1 if a pair was written, 0 otherwise.
+ */
+static inline int testPair(const Collider *a, const Collider *b, CollisionPair *pair)
+{
+    if (!(a->mask & b->layer) && !(b->mask & a->layer))
+        return 0;
+
+    BoundingBox boxA = a->box;
+    BoundingBox boxB = b->box;
+    if (!checkCollision(&boxA, &boxB))
+        return 0;
+
+    if (a->layer > b->layer)
+    {
+        const Collider *swap = a;
+        a = b;
+        b = swap;
+    }
+    pair->layerA = a->layer;
+    pair->layerB = b->layer;
+    pair->idA = a->id;
+    pair->idB = b->id;
+    return 1;
+}
+
+int broadphaseFindPairs(Broadphase *broadphase, CollisionPair *pairs, int maxPairs)
+{
+    // Half of the neighbours, so each pair of cells is visited once
+    static const int8_t forward[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+    sortByCell(broadphase);
+
+    const Collider *colliders = broadphase->colliders;
+    const uint16_t *order = broadphase->order;
+    const uint16_t *start = broadphase->cellStart;
+    int found = 0;
+
+    for (int row = 0; row < BROADPHASE_ROWS; row++)
+    {
+        for (int column = 0; column < BROADPHASE_COLUMNS; column++)
+        {
+            int cell = row * BROADPHASE_COLUMNS + column;
+            for (int i = start[cell]; i < start[cell + 1]; i++)
+            {
+                const Collider *a = &colliders[order[i]];
+
+                // The rest of this cell
+                for (int j = i + 1; j < start[cell + 1]; j++)
+                {
+                    if (found == maxPairs)
+                        return found;
+                    found += testPair(a, &colliders[order[j]], &pairs[found]);
+                }
+
+                // The neighbours ahead of it
+                for (int n = 0; n < 4; n++)
+                {
+                    int nextColumn = column + forward[n][0];
+                    int nextRow = row + forward[n][1];
+                    if (nextColumn < 0 || nextColumn >= BROADPHASE_COLUMNS || nextRow >= BROADPHASE_ROWS)
+                        continue;
+
+                    int next = nextRow * BROADPHASE_COLUMNS + nextColumn;
+                    for (int j = start[next]; j < start[next + 1]; j++)
+                    {
+                        if (found == maxPairs)
+                            return found;
+                        found += testPair(a, &colliders[order[j]], &pairs[found]);
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file broadphase.h
+ * @brief Uniform grid broadphase for collision detection.
+ *
+ * The screen is cut into BROADPHASE_CELL_SIZE square cells. Each collider
+ * is bucketed by the cell of its center, and a pair is only tested when
+ * the two centers are in the same or in neighbouring cells. That holds
+ * every overlap as long as no box is wider or higher than a cell.
+ * Colliders off the screen are clamped to the edge cells.
+ *
+ * Each collider has a layer (one bit) and a mask of the layers it hits;
+ * a pair is reported when either side's mask has the other's layer.
+ */
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "boundingBox.h"
+#include "initialize.h"
+
+/** @brief Side of a grid cell, in pixels. No collider may be larger. */
+#define BROADPHASE_CELL_SIZE 16
+/** @brief Columns of cells across the screen. */
+#define BROADPHASE_COLUMNS (SCREEN_WIDTH / BROADPHASE_CELL_SIZE)
+/** @brief Rows of cells down the screen. */
+#define BROADPHASE_ROWS (SCREEN_HEIGHT / BROADPHASE_CELL_SIZE)
+/** @brief Cells in the grid. */
+#define BROADPHASE_CELLS (BROADPHASE_COLUMNS * BROADPHASE_ROWS)
+
+/**
+ * @brief Something that can collide.
+ */
+typedef struct
+{
+    BoundingBox box; /**< Box centered on the collider. */
+    uint16_t id;     /**< Caller's name for it, such as a pool slot. */
+    uint8_t layer;   /**< Layer bit it is on. */
+    uint8_t mask;    /**< Layers it collides with. */
+} Collider;
+
+/**
+ * @brief Two overlapping colliders, the one on the lower layer bit first.
+ */
+typedef struct
+{
+    uint8_t layerA; /**< Layer of the first collider. */
+    uint8_t layerB; /**< Layer of the second collider. */
+    uint16_t idA;   /**< Id of the first collider. */
+    uint16_t idB;   /**< Id of the second collider. */
+} CollisionPair;
+
+/**
+ * @brief Colliders of one step, bucketed by cell.
+ *
+ * The storage is the caller's, so the game and the benchmarks can size it.
+ */
+typedef struct
+{
+    Collider *colliders;                      /**< Colliders, in insertion order. */
+    uint16_t *order;                          /**< Collider indices sorted by cell. */
+    uint8_t *cells;                           /**< Cell of each collider. */
+    int capacity;                             /**< Room in the three arrays. */
+    int count;                                /**< Colliders added since the last clear. */
+    uint16_t cellStart[BROADPHASE_CELLS + 1]; /**< Where each cell begins in order. */
+} Broadphase;
+
+/**
+ * @brief Sets up a broadphase over caller storage.
+ * @param broadphase Broadphase to set up.
+ * @param colliders Room for capacity colliders.
+ * @param order Room for capacity indices.
+ * @param cells Room for capacity cells.
+ * @param capacity Most colliders per step.
+ */
+void broadphaseInit(Broadphase *broadphase, Collider *colliders, uint16_t *order, uint8_t *cells, int capacity);
+
+/**
+ * @brief Removes every collider.
+ * @param broadphase Broadphase to clear.
+ */
+void broadphaseClear(Broadphase *broadphase);
+
+/**
+ * @brief Adds a collider.
+ * @param broadphase Broadphase to add to.
+ * @param box Box of the collider, at most BROADPHASE_CELL_SIZE each way.
+ * @param layer Layer bit of the collider.
+ * @param mask Layers it collides with.
+ * @param id Name reported back in pairs.
+ * @return false if the broadphase is full.
+ */
+bool broadphaseAdd(Broadphase *broadphase, BoundingBox box, uint8_t layer, uint8_t mask, uint16_t id);
+
+/**
+ * @brief Finds every overlapping pair among the colliders added.
+ * @param broadphase Broadphase to search.
+ * @param pairs Where to write the pairs.
+ * @param maxPairs Room in pairs; any further pairs are dropped.
+ * @return Number of pairs written.
+ */
+int broadphaseFindPairs(Broadphase *broadphase, CollisionPair *pairs, int maxPairs);
+
+#endif // BROADPHASE_H
@@ -0,0 +1,133 @@
+/**
+ * @file entityPool.h
+ * @brief Fixed-capacity pools for the entity stores.
+ *
+ * ENTITY_POOL generates a pool type and its functions for one capacity.
+ * A pool hands out slot indices; the store that embeds it keeps one array
+ * per field, indexed by slot.
+ *
+ * - Spawning pops the head of an intrusive free list: a free slot's link
+ *   holds the next free slot, so there is no separate list to keep. Slots
+ *   never used yet are past a high-water mark instead, so a pool of all
+ *   zeros (a global before init) is valid and empty.
+ * - Live slots are also packed at the front of `dense`, and a live slot's
+ *   link holds its position there. Despawning moves the last live slot into
+ *   the hole, so both operations are O(1) and loops visit only live slots.
+ * - Every spawn and despawn bumps the slot's generation, odd while live.
+ *   A handle pairs a slot with its generation and stops resolving once
+ *   the entity it named is gone, even if the slot was reused.
+ */
+
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Names an entity: generation in the high half, slot in the low half. */
+typedef uint32_t EntityHandle;
+
+/** @brief A handle that never resolves. */
+#define ENTITY_HANDLE_NONE 0xFFFFFFFFu
+
+/**
+ * @brief Loops over the live slots of a pool.
+ *
+ * Walks `dense` from the back, so the current slot may be despawned (its
+ * place is taken by a slot already visited) and slots spawned inside the
+ * loop are not visited. `break` works.
+ *
+ * @param slot Name of the slot variable.
+ * @param pool Pointer to the pool.
+ */
+#define ENTITY_POOL_FOR_EACH(slot, pool) \
+    for (int slot##Position = (pool)->count - 1, slot; slot##Position >= 0 && ((slot = (pool)->dense[slot##Position]), 1); slot##Position--)
+
+/**
+ * @brief Declares a pool type and its functions.
+ *
+ * For ENTITY_POOL(AsteroidPool, asteroidPool, 10) this declares the type
+ * AsteroidPool and asteroidPoolInit, asteroidPoolSpawn, asteroidPoolDespawn,
+ * asteroidPoolAlive, asteroidPoolHandle and asteroidPoolResolve.
+ *
+ * @param Type Name of the pool type.
+ * @param prefix Prefix of the functions.
+ * @param capacity Most live entities (at most 65535).
+ */
+#define ENTITY_POOL(Type, prefix, capacity)                                                  \
+    typedef struct                                                                           \
+    {                                                                                        \
+        uint16_t count;               /**< Live entities. */                                 \
+        uint16_t used;                /**< Slots ever handed out since init. */              \
+        uint16_t freeHead;            /**< First free slot + 1, 0 when none. */              \
+        uint16_t dense[capacity];     /**< Live slots, packed at the front. */               \
+        uint16_t link[capacity];      /**< Live: position in dense. Free: next free + 1. */  \
+        uint8_t generation[capacity]; /**< Odd while live. */                                \
+    } Type;                                                                                  \
+                                                                                             \
+    /** @brief Empties the pool; handles to its entities stop resolving. */                  \
+    static inline void prefix##Init(Type *pool)                                              \
+    {                                                                                        \
+        for (int i = 0; i < pool->used; i++)                                                 \
+            pool->generation[i] += pool->generation[i] & 1;                                  \
+        pool->count = 0;                                                                     \
+        pool->used = 0;                                                                      \
+        pool->freeHead = 0;                                                                  \
+    }                                                                                        \
+                                                                                             \
+    /** @brief Takes a free slot. Returns it, or -1 if the pool is full. */                  \
+    static inline int prefix##Spawn(Type *pool)                                              \
+    {                                                                                        \
+        int slot;                                                                            \
+        if (pool->freeHead)                                                                  \
+        {                                                                                    \
+            slot = pool->freeHead - 1;                                                       \
+            pool->freeHead = pool->link[slot];                                               \
+        }                                                                                    \
+        else if (pool->used < (capacity))                                                    \
+            slot = pool->used++;                                                             \
+        else                                                                                 \
+            return -1;                                                                       \
+        pool->link[slot] = pool->count;                                                      \
+        pool->dense[pool->count++] = slot;                                                   \
+        pool->generation[slot]++;                                                            \
+        return slot;                                                                         \
+    }                                                                                        \
+                                                                                             \
+    /** @brief Tells whether a slot is live. */                                              \
+    static inline bool prefix##Alive(const Type *pool, int slot)                             \
+    {                                                                                        \
+        return pool->generation[slot] & 1;                                                   \
+    }                                                                                        \
+                                                                                             \
+    /** @brief Frees a slot; does nothing if it is already free. */                          \
+    static inline void prefix##Despawn(Type *pool, int slot)                                 \
+    {                                                                                        \
+        if (!prefix##Alive(pool, slot))                                                      \
+            return;                                                                          \
+        int position = pool->link[slot];                                                     \
+        int last = pool->dense[--pool->count];                                               \
+        pool->dense[position] = last;                                                        \
+        pool->link[last] = position;                                                         \
+        pool->link[slot] = pool->freeHead;                                                   \
+        pool->freeHead = slot + 1;                                                           \
+        pool->generation[slot]++;                                                            \
+    }                                                                                        \
+                                                                                             \
+    /** @brief Names the entity in a live slot. */                                           \
+    static inline EntityHandle prefix##Handle(const Type *pool, int slot)                    \
+    {                                                                                        \
+        return ((EntityHandle)pool->generation[slot] << 16) | (EntityHandle)slot;            \
+    }                                                                                        \
+                                                                                             \
+    /** @brief Finds the slot of a handle. Returns -1 if its entity is gone. */              \
+    static inline int prefix##Resolve(const Type *pool, EntityHandle handle)                 \
+    {                                                                                        \
+        uint32_t slot = handle & 0xFFFF;                                                     \
+        if (slot >= (capacity) || pool->generation[slot] != (handle >> 16) ||                \
+            !prefix##Alive(pool, (int)slot))                                                 \
+            return -1;                                                                       \
+        return (int)slot;                                                                    \
+    }
+
+#endif // ENTITY_POOL_H
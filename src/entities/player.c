@@ -21,6 +21,8 @@
 #include "display.h"
 #include "boundingBox.h"
 #include "asteroids.h"
+#include "sprites.h"
+#include "random.h"
 
 /**
  * @brief Global variable for the Player.
@@ -28,9 +30,9 @@
 Player player;
 
 /**
- * @brief Global array for the bullets.
+ * @brief Global store for the bullets.
  */
-Bullet bullets[MAX_BULLETS];
+BulletStore bullets;
 
 /**
  * @brief Time of invulnerability for player
@@ -44,10 +46,7 @@ int playerInvulnerableTimer = 90;
  */
 void initBullets()
 {
-    for (int i = 0; i < MAX_BULLETS; i++)
-    {
-        bullets[i].active = 0;
-    }
+    bulletPoolInit(&bullets.pool);
 }
 
 /**
@@ -57,16 +56,13 @@ void initBullets()
  */
 void updateBullets()
 {
-    for (int i = 0; i < MAX_BULLETS; i++)
+    ENTITY_POOL_FOR_EACH(i, &bullets.pool)
     {
-        if (bullets[i].active)
+        bullets.x[i] += bullets.dx[i];
+        bullets.y[i] += bullets.dy[i];
+        if (bullets.x[i] < 0 || bullets.x[i] >= SCREEN_WIDTH || bullets.y[i] < 0 || bullets.y[i] >= SCREEN_HEIGHT)
         {
-            bullets[i].box.x += bullets[i].dx;
-            bullets[i].box.y += bullets[i].dy;
-            if (bullets[i].box.x < 0 || bullets[i].box.x >= SCREEN_WIDTH || bullets[i].box.y < 0 || bullets[i].box.y >= SCREEN_HEIGHT)
-            {
-                bullets[i].active = 0;
-            }
+            bulletPoolDespawn(&bullets.pool, i);
         }
     }
 }
@@ -75,15 +71,14 @@ void updateBullets()
  * @brief Draws the bullets.
  *
  * Print all active bullets to the screen
+ *
+ * @param store Bullets to draw (the global store or a frame snapshot).
  */
-void drawBullets()
+void drawBullets(const BulletStore *store)
 {
-    for (int i = 0; i < MAX_BULLETS; i++)
+    ENTITY_POOL_FOR_EACH(i, &store->pool)
     {
-        if (bullets[i].active)
-        {
-            ssd1306_draw_char(&display, bullets[i].box.x, bullets[i].box.y, 1, '>');
-        }
+        ssd1306_draw_sprite(&display, &bulletSprite, store->x[i], store->y[i]);
     }
 }
 
@@ -114,12 +109,15 @@ void initPlayer(Player *player)
  */
 void initPlayerParticles(Player *player)
 {
-    for (int i = 0; i < MAX_PARTICLES; i++)
+    ParticleStore *particles = &player->particles;
+    particlePoolInit(&particles->pool);
+    for (int n = 0; n < MAX_PARTICLES; n++)
     {
-        player->particles[i].x = player->box.x;
-        player->particles[i].y = player->box.y;
-        player->particles[i].dx = -1;
-        player->particles[i].time = 0;
+        int i = particlePoolSpawn(&particles->pool);
+        particles->x[i] = player->box.x;
+        particles->y[i] = player->box.y;
+        particles->dx[i] = -1;
+        particles->time[i] = 0;
     }
 }
 
@@ -172,32 +170,45 @@ void movePlayer(Player *player, int deltaX, int deltaY)
  * @brief Draws the Player.
  *
  * Draws the spaceship using the current location, and draws particles.
+ * Drawing does not change the player, so it can be done from a snapshot.
  *
  * @param player Pointer to the Player structure.
  */
-void drawPlayer(Player *player)
+void drawPlayer(const Player *player)
 {
-    char text[4] = "]=D";
-    int textWidth = 5 * strlen(text); // Assuming that the default font has 5 pixels of width
-    ssd1306_draw_string(&display, player->box.x - player->box.w / 2, player->box.y, 1, text);
+    ssd1306_draw_sprite(&display, &playerSprite, player->box.x - player->box.w / 2, player->box.y);
 
     // Draw Particles
-    for (int i = 0; i < MAX_PARTICLES; i++)
+    const ParticleStore *particles = &player->particles;
+    ENTITY_POOL_FOR_EACH(i, &particles->pool)
     {
-        if (player->particles[i].time >= 0)
+        ssd1306_draw_pixel(&display, particles->x[i], particles->y[i]);
+    }
+}
+
+/**
+ * @brief Updates the Player's particles.
+ *
+ * Moves every live particle and respawns it behind the ship once its
+ * time runs out.
+ *
+ * @param player Pointer to the Player structure.
+ */
+void updatePlayerParticles(Player *player)
+{
+    ParticleStore *particles = &player->particles;
+    ENTITY_POOL_FOR_EACH(i, &particles->pool)
+    {
+        particles->x[i] += particles->dx[i];
+        particles->time[i]--;
+
+        // Reset particle upon reaching time limit
+        if (particles->time[i] <= 0)
         {
-            ssd1306_draw_pixel(&display, player->particles[i].x, player->particles[i].y);
-            player->particles[i].x += player->particles[i].dx;
-            player->particles[i].time--;
-
-            // Reset particle upon reaching time limit
-            if (player->particles[i].time <= 0)
-            {
-                player->particles[i].x = player->box.x - player->box.w / 2;
-                player->particles[i].y = player->box.y + rand() % 5;
-                player->particles[i].dx = -1 - rand() % 2;
-                player->particles[i].time = 8 + rand() % 4;
-            }
+            particles->x[i] = player->box.x - player->box.w / 2;
+            particles->y[i] = player->box.y + randomBelow(RANDOM_PARTICLES, 5);
+            particles->dx[i] = -1 - (int)randomBelow(RANDOM_PARTICLES, 2);
+            particles->time[i] = 8 + randomBelow(RANDOM_PARTICLES, 4);
         }
     }
 }
@@ -211,48 +222,78 @@ void drawPlayer(Player *player)
  */
 void shoot(Player *player)
 {
-    for (int i = 0; i < MAX_BULLETS; i++)
+    int i = bulletPoolSpawn(&bullets.pool);
+    if (i < 0)
+        return;
+
+    bullets.x[i] = player->box.x + 10;
+    bullets.y[i] = player->box.y;
+    bullets.dx[i] = 4;
+    bullets.dy[i] = 0;
+}
+
+/**
+ * @brief Finds every collision of the step.
+ *
+ * Puts the player, the bullets and the asteroids in the broadphase and
+ * collects every overlapping pair, for checkPlayerCollision and
+ * checkBulletsCollisions to consume.
+ *
+ * @param player Pointer to the Player structure.
+ * @param pairs Room for MAX_COLLISION_PAIRS pairs.
+ * @return Number of pairs found.
+ */
+int findCollisions(const Player *player, CollisionPair *pairs)
+{
+    static Collider colliders[MAX_COLLIDERS];
+    static uint16_t order[MAX_COLLIDERS];
+    static uint8_t cells[MAX_COLLIDERS];
+    static Broadphase broadphase;
+
+    broadphaseInit(&broadphase, colliders, order, cells, MAX_COLLIDERS);
+
+    broadphaseAdd(&broadphase, player->box, COLLIDER_PLAYER, COLLIDER_ASTEROID, 0);
+    ENTITY_POOL_FOR_EACH(i, &bullets.pool)
     {
-        if (!bullets[i].active)
-        {
-            bullets[i].box.x = player->box.x + 10;
-            bullets[i].box.y = player->box.y;
-            bullets[i].box.w = 2;
-            bullets[i].box.h = 6;
-            bullets[i].dx = 4;
-            bullets[i].dy = 0;
-            bullets[i].active = 1;
-            break;
-        }
+        broadphaseAdd(&broadphase, bulletBox(&bullets, i), COLLIDER_BULLET, COLLIDER_ASTEROID, i);
     }
+    ENTITY_POOL_FOR_EACH(i, &asteroids.pool)
+    {
+        broadphaseAdd(&broadphase, asteroidBox(&asteroids, i), COLLIDER_ASTEROID, 0, i);
+    }
+
+    return broadphaseFindPairs(&broadphase, pairs, MAX_COLLISION_PAIRS);
 }
 
 /**
  * @brief Checks for collisions between the Player and asteroids.
  *
- * Checks if the Player's bounding box intersects with any active asteroid's
- * bounding box.
+ * Looks for a player and asteroid pair among the collisions of the step
+ * and destroys the asteroid.
  *
+ * @param player Pointer to the Player structure.
+ * @param pairs Collisions found by findCollisions.
+ * @param count Number of pairs.
  * @return true if a collision occurs, false otherwise.
  * @note The variable `playerInvulnerableTimer` prevent the player of dying in start of game or after a respawn.
  */
-bool checkPlayerCollision(Player *player)
+bool checkPlayerCollision(Player *player, const CollisionPair *pairs, int count)
 {
+    (void)player;
+
     // Se o player está invulnerável, não verificar colisões
     if (playerInvulnerableTimer > 0)
         return false;
 
-    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    for (int i = 0; i < count; i++)
     {
-        if (asteroids[i].active)
-        {
-            BoundingBox _playerBox = player->box;
-            if (checkCollision(&_playerBox, &asteroids[i].box))
-            {
-                asteroids[i].active = 0;
-                return true;
-            }
-        }
+        if (pairs[i].layerA != COLLIDER_PLAYER || pairs[i].layerB != COLLIDER_ASTEROID)
+            continue;
+        if (!asteroidPoolAlive(&asteroids.pool, pairs[i].idB))
+            continue;
+
+        asteroidPoolDespawn(&asteroids.pool, pairs[i].idB);
+        return true;
     }
     return false;
 }
@@ -260,30 +301,27 @@ bool checkPlayerCollision(Player *player)
 /**
  * @brief Checks for collisions between the bullets and asteroids.
  *
- * Checks if any active bullet's bounding box intersects with any active
- * asteroid's bounding box.
+ * Destroys both sides of every bullet and asteroid pair among the
+ * collisions of the step. A bullet or asteroid already destroyed this step
+ * is skipped, so each bullet kills at most one asteroid.
  *
- * @return true if a collision occurs, false otherwise.
+ * @param pairs Collisions found by findCollisions.
+ * @param count Number of pairs.
+ * @return Number of asteroids destroyed.
  */
-bool checkBulletsCollisions()
+int checkBulletsCollisions(const CollisionPair *pairs, int count)
 {
-    for (int i = 0; i < MAX_BULLETS; i++)
+    int kills = 0;
+    for (int i = 0; i < count; i++)
     {
-        if (bullets[i].active)
-        {
-            for (int j = 0; j < MAX_ASTEROIDS; j++)
-            {
-                if (asteroids[j].active)
-                {
-                    if (checkCollision(&bullets[i].box, &asteroids[j].box))
-                    {
-                        bullets[i].active = 0;
-                        asteroids[j].active = 0;
-                        return true;
-                    }
-                }
-            }
-        }
+        if (pairs[i].layerA != COLLIDER_BULLET || pairs[i].layerB != COLLIDER_ASTEROID)
+            continue;
+        if (!bulletPoolAlive(&bullets.pool, pairs[i].idA) || !asteroidPoolAlive(&asteroids.pool, pairs[i].idB))
+            continue;
+
+        bulletPoolDespawn(&bullets.pool, pairs[i].idA);
+        asteroidPoolDespawn(&asteroids.pool, pairs[i].idB);
+        kills++;
     }
-    return false;
+    return kills;
 }
\ No newline at end of file
@@ -13,42 +13,89 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "boundingBox.h"
+#include "broadphase.h"
+#include "entityPool.h"
+#include "asteroids.h"
 
 /** @brief Max amount of bullets in game */
+#ifndef MAX_BULLETS
 #define MAX_BULLETS 3
+#endif
 /** @brief Max amount of particles generated by the player */
+#ifndef MAX_PARTICLES
 #define MAX_PARTICLES 10
+#endif
+
+/** @brief Width of a bullet's bounding box */
+#define BULLET_WIDTH 2
+/** @brief Height of a bullet's bounding box */
+#define BULLET_HEIGHT 6
+
+/** @brief Broadphase layers of the things that collide. */
+enum
+{
+    COLLIDER_PLAYER = 1 << 0,
+    COLLIDER_BULLET = 1 << 1,
+    COLLIDER_ASTEROID = 1 << 2,
+};
+
+/** @brief Colliders in one step: the player, the bullets and the asteroids. */
+#define MAX_COLLIDERS (1 + MAX_BULLETS + MAX_ASTEROIDS)
+/** @brief Most collisions in one step: everything else against every asteroid. */
+#define MAX_COLLISION_PAIRS ((1 + MAX_BULLETS) * MAX_ASTEROIDS)
+
+/** @brief Pool of particle slots. */
+ENTITY_POOL(ParticlePool, particlePool, MAX_PARTICLES)
+
+/** @brief Pool of bullet slots. */
+ENTITY_POOL(BulletPool, bulletPool, MAX_BULLETS)
 
 /**
- * @brief Structure to represent a ship's particle.
+ * @brief Store of the ship's exhaust particles, one array per field.
  */
 typedef struct
 {
-    int x;    /**< X-coordinate of the particle. */
-    int y;    /**< Y-coordinate of the particle. */
-    int dx;   /**< X-direction of the particle. */
-    int time; /**< Time alive for particle. */
-} ShipParticle;
+    ParticlePool pool;          /**< Which slots are live. */
+    int16_t x[MAX_PARTICLES];   /**< X-coordinate of the particle. */
+    int16_t y[MAX_PARTICLES];   /**< Y-coordinate of the particle. */
+    int8_t dx[MAX_PARTICLES];   /**< X-direction of the particle. */
+    int8_t time[MAX_PARTICLES]; /**< Time alive for particle. */
+} ParticleStore;
 
 /**
  * @brief Structure to represent the Player.
  */
 typedef struct
 {
-    BoundingBox box;                       /**< Bounding box for collision detection. */
-    ShipParticle particles[MAX_PARTICLES]; /**< Array of particles */
+    BoundingBox box;         /**< Bounding box for collision detection. */
+    ParticleStore particles; /**< Exhaust particles */
 } Player;
 
 /**
- * @brief Structure for Bullet
+ * @brief Bullet store, one array per field.
+ *
+ * Every bullet is BULLET_WIDTH by BULLET_HEIGHT, so the size isn't stored.
  */
 typedef struct
 {
-    BoundingBox box; /**< Bounding box for collision detection. */
-    int dx;          /**< Velocity for axis x of the bullet. */
-    int dy;          /**< Velocity for axis y of the bullet. */
-    int active;      /**< Bullet if exist or not in game. */
-} Bullet;
+    BulletPool pool;        /**< Which slots are in game. */
+    int16_t x[MAX_BULLETS]; /**< Center, horizontal. */
+    int16_t y[MAX_BULLETS]; /**< Center, vertical. */
+    int8_t dx[MAX_BULLETS]; /**< Velocity for axis x of the bullet. */
+    int8_t dy[MAX_BULLETS]; /**< Velocity for axis y of the bullet. */
+} BulletStore;
+
+/**
+ * @brief Bounding box of a bullet, for collision detection.
+ * @param store Bullet store.
+ * @param i Index of the bullet.
+ * @return Box centered on the bullet.
+ */
+static inline BoundingBox bulletBox(const BulletStore *store, int i)
+{
+    BoundingBox box = {store->x[i], store->y[i], BULLET_WIDTH, BULLET_HEIGHT};
+    return box;
+}
 
 /**
  * @brief Initializes the Player in the center of the screen.
@@ -68,13 +115,30 @@ void movePlayer(Player *player, int deltaX, int deltaY);
  * @brief Draws the Player.
  * @param player Pointer to the Player structure.
  */
-void drawPlayer(Player *player);
+void drawPlayer(const Player *player);
+
+/**
+ * @brief Moves the Player's particles and respawns the expired ones.
+ * @param player Pointer to the Player structure.
+ */
+void updatePlayerParticles(Player *player);
+
+/**
+ * @brief Finds every collision of the step.
+ * @param player Pointer to the Player structure.
+ * @param pairs Room for MAX_COLLISION_PAIRS pairs.
+ * @return Number of pairs found.
+ */
+int findCollisions(const Player *player, CollisionPair *pairs);
 
 /**
  * @brief Checks for collisions between the Player and asteroids.
+ * @param player Pointer to the Player structure.
+ * @param pairs Collisions found by findCollisions.
+ * @param count Number of pairs.
  * @return true if a collision occurs, false otherwise.
  */
-bool checkPlayerCollision(Player *player);
+bool checkPlayerCollision(Player *player, const CollisionPair *pairs, int count);
 
 /**
  * @brief Initializes the Player's particles.
@@ -94,8 +158,9 @@ void updateBullets();
 
 /**
  * @brief Draws the bullets.
+ * @param store Bullets to draw.
  */
-void drawBullets();
+void drawBullets(const BulletStore *store);
 
 /**
  * @brief Makes the player shoot.
@@ -104,15 +169,17 @@ void drawBullets();
 void shoot(Player *player);
 
 /**
- * @brief Checks for collisions between the bullets and asteroids.
- * @return true if a collision occurs, false otherwise.
+ * @brief Destroys the bullets and asteroids that collided.
+ * @param pairs Collisions found by findCollisions.
+ * @param count Number of pairs.
+ * @return Number of asteroids destroyed.
  */
-bool checkBulletsCollisions();
+int checkBulletsCollisions(const CollisionPair *pairs, int count);
 
 /** @brief Global variable for the Player. */
 extern Player player;
-/** @brief Global array for the Bullets. */
-extern Bullet bullets[MAX_BULLETS];
+/** @brief Global store for the Bullets. */
+extern BulletStore bullets;
 /** @brief Time of invulnerablity for player*/
 extern int playerInvulnerableTimer;
 
@@ -11,11 +11,12 @@
 #include <stdlib.h>
 #include "initialize.h"
 #include "display.h"
+#include "random.h"
 
 /**
  * @brief Global array for the stars.
  */
-Star stars[10];
+Star stars[MAX_STARS];
 
 /**
  * @brief Initializes the stars.
@@ -24,10 +25,10 @@ Star stars[10];
  */
 void initStars()
 {
-    for (int i = 0; i < 10; i++)
+    for (int i = 0; i < MAX_STARS; i++)
     {
-        stars[i].x = rand() % SCREEN_WIDTH;
-        stars[i].y = rand() % SCREEN_HEIGHT;
+        stars[i].x = randomBelow(RANDOM_STARS, SCREEN_WIDTH);
+        stars[i].y = randomBelow(RANDOM_STARS, SCREEN_HEIGHT);
     }
 }
 
@@ -39,15 +40,15 @@ void initStars()
  *
  * @param starsSpeed Speed of the stars.
  */
-void moveStars(float starsSpeed)
+void moveStars(fixed_t starsSpeed)
 {
-    for (int i = 0; i < 10; i++)
+    for (int i = 0; i < MAX_STARS; i++)
     {
-        stars[i].x -= starsSpeed;
+        stars[i].x = fxToInt(fxFromInt(stars[i].x) - starsSpeed);
         if (stars[i].x < 0)
         {
             stars[i].x = SCREEN_WIDTH;
-            stars[i].y = rand() % SCREEN_HEIGHT;
+            stars[i].y = randomBelow(RANDOM_STARS, SCREEN_HEIGHT);
         }
     }
 }
@@ -57,11 +58,14 @@ void moveStars(float starsSpeed)
  *
  * This function draws the stars on the screen using the
  * ssd1306_draw_pixel function.
+ *
+ * @param list Stars to draw (the global array or a frame snapshot).
+ * @param count Amount of stars in the list.
  */
-void drawStars()
+void drawStars(const Star *list, int count)
 {
-    for (int i = 0; i < 10; i++)
+    for (int i = 0; i < count; i++)
     {
-        ssd1306_draw_pixel(&display, stars[i].x, stars[i].y);
+        ssd1306_draw_pixel(&display, list[i].x, list[i].y);
     }
 }
\ No newline at end of file
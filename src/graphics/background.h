@@ -10,9 +10,12 @@
 #define BACKGROUND_H
 
 #include <stdint.h>
+#include "fixedMath.h"
 
 /** @brief The Star speed */
 #define STARS_SPEED 1
+/** @brief Amount of stars in the background */
+#define MAX_STARS 10
 
 /**
  * @brief Structure to represent a star.
@@ -32,14 +35,16 @@ void initStars();
  * @brief Moves the stars.
  * @param starsSpeed Speed of the stars.
  */
-void moveStars(float starsSpeed);
+void moveStars(fixed_t starsSpeed);
 
 /**
  * @brief Draws the stars.
+ * @param list Stars to draw.
+ * @param count Amount of stars in the list.
  */
-void drawStars();
+void drawStars(const Star *list, int count);
 
 /** @brief Global array to manage stars*/
-extern Star stars[10];
+extern Star stars[MAX_STARS];
 
 #endif // BACKGROUND_H
\ No newline at end of file
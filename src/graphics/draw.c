@@ -22,4 +22,19 @@
 void drawImage(const uint8_t *data, const long size, int x, int y)
 {
     ssd1306_bmp_show_image_with_offset(&display, data, size, x, y);
+}
+
+/**
+ * @brief Draws a page-packed image on the SSD1306 display.
+ *
+ * Unlike drawImage, the image is already in the display's page layout, so
+ * it is copied in byte runs instead of being decoded pixel by pixel.
+ *
+ * @param image Image generated at build time from src/assets/images.
+ * @param x X-coordinate of the top-left corner of the image.
+ * @param y Y-coordinate of the top-left corner of the image.
+ */
+void drawPackedImage(const ssd1306_image_t *image, int x, int y)
+{
+    ssd1306_draw_image(&display, image, x, y);
 }
\ No newline at end of file
@@ -20,4 +20,13 @@
  */
 void drawImage(const uint8_t *data, const long size, int x, int y);
 
+/**
+ * @brief Draws a page-packed image on the SSD1306 display.
+ *
+ * @param image Image generated at build time from src/assets/images.
+ * @param x X-coordinate of the top-left corner of the image.
+ * @param y Y-coordinate of the top-left corner of the image.
+ */
+void drawPackedImage(const ssd1306_image_t *image, int x, int y);
+
 #endif // DRAW_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+ * @file sprites.c
+ * @brief Implementation for the sprites module.
+ *
+ * The sprites are the glyphs the entities used to be drawn with, taken
+ * column by column from font_8x5. Their mask is the bitmap itself, so they
+ * are ored into the frame exactly like the text they replace.
+ */
+
+#include "sprites.h"
+
+/**
+ * @brief Pixels of the player's ship: ']', '=' and 'D' with one blank column between them.
+ */
+static const uint8_t playerSpriteBits[] = {
+    0x00, 0x41, 0x41, 0x41, 0x7F, 0x00,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x00,
+    0x7F, 0x41, 0x41, 0x41, 0x3E,
+};
+
+/**
+ * @brief Pixels of a bullet: the '>' glyph.
+ */
+static const uint8_t bulletSpriteBits[] = {
+    0x00, 0x41, 0x22, 0x14, 0x08,
+};
+
+const ssd1306_sprite_t playerSprite = {
+    .width = sizeof(playerSpriteBits),
+    .height = 8,
+    .bits = playerSpriteBits,
+    .mask = playerSpriteBits,
+};
+
+const ssd1306_sprite_t bulletSprite = {
+    .width = sizeof(bulletSpriteBits),
+    .height = 8,
+    .bits = bulletSpriteBits,
+    .mask = bulletSpriteBits,
+};
@@ -0,0 +1,21 @@
+/**
+ * @file sprites.h
+ * @brief Header file for the sprites module.
+ *
+ * This module holds the sprites of the game entities, stored in the
+ * display's page layout so each entity is drawn with a single blit.
+ */
+
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+/** @brief Sprite of the player's ship ("]=D"). */
+extern const ssd1306_sprite_t playerSprite;
+
+/** @brief Sprite of a bullet ('>'). */
+extern const ssd1306_sprite_t bulletSprite;
+
+#endif // SPRITES_H
@@ -69,19 +69,24 @@ void drawTextCentered(char *text, int _y)
  * @param y Y-coordinate of the wave.
  * @param speed Speed of the wave animation.
  * @param amplitude Amplitude of the wave.
- * @note This function is not generic, because of the static float variable.
+ * @note This function is not generic, because of the static time variable.
  */
-void drawWave(int y, float speed, float amplitude)
+void drawWave(int y, fixed_t speed, fixed_t amplitude)
 {
-    static float time = 0;
-    time += speed / 100.0;
+    static fixed_t time = 0;
+    time += speed / 100;
+    // Keep the phase in one turn so it never overflows
+    if (time >= FX_CONST(6.283185307))
+    {
+        time -= FX_CONST(6.283185307);
+    }
     int _points = 12;
     for (int i = 0; i < _points; i++)
     {
         int _x1 = SCREEN_WIDTH / _points * i;
         int _x2 = SCREEN_WIDTH / _points * (i + 1);
-        int _y1 = y + sin(time + i * 30) * amplitude;
-        int _y2 = y + sin(time + (i + 1) * 30) * amplitude;
+        int _y1 = fxToInt(fxFromInt(y) + fxMul(fxSin(time + fxFromInt(i * 30)), amplitude));
+        int _y2 = fxToInt(fxFromInt(y) + fxMul(fxSin(time + fxFromInt((i + 1) * 30)), amplitude));
         ssd1306_draw_line(&display, _x1, _y1, _x2, _y2);
     }
 }
\ No newline at end of file
@@ -9,7 +9,7 @@
  #define TEXT_H
  
  #include "display.h"
- #include <math.h>
+ #include "fixedMath.h"
  
  /**
   * @brief Draws text for a header.
@@ -40,6 +40,6 @@
   * @param speed Speed of the wave animation.
   * @param amplitude Amplitude of the wave.
   */
- void drawWave(int y, float speed, float amplitude);
+ void drawWave(int y, fixed_t speed, fixed_t amplitude);
  
  #endif
\ No newline at end of file
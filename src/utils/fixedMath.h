@@ -0,0 +1,104 @@
+/**
+ * @file fixedMath.h
+ * @brief Header file for the fixed-point math module.
+ *
+ * The RP2040 has no FPU, so game logic works with Q16.16 fixed-point
+ * numbers: 16 integer bits and 16 fractional bits in an int32_t.
+ */
+
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <stdint.h>
+
+/** @brief Q16.16 fixed-point number */
+typedef int32_t fixed_t;
+
+/** @brief Number of fractional bits */
+#define FX_SHIFT 16
+/** @brief The value 1.0 */
+#define FX_ONE ((fixed_t)1 << FX_SHIFT)
+
+/** @brief Converts an integer constant to fixed-point */
+#define FX_FROM_INT(i) ((fixed_t)(i) * FX_ONE)
+
+/**
+ * @brief Converts a decimal constant to fixed-point, rounding to nearest.
+ *
+ * Meant for literals: the conversion is folded by the compiler, so no
+ * floating-point code is generated.
+ */
+#define FX_CONST(x) ((fixed_t)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+/**
+ * @brief Converts an integer to fixed-point.
+ * @param i Integer in the range [-32768, 32767].
+ * @return The fixed-point value.
+ */
+static inline fixed_t fxFromInt(int32_t i)
+{
+    return i * FX_ONE;
+}
+
+/**
+ * @brief Converts a fixed-point value to an integer.
+ *
+ * Truncates toward zero, like the float to int conversion it replaces.
+ *
+ * @param a Fixed-point value.
+ * @return The integer part of the value.
+ */
+static inline int32_t fxToInt(fixed_t a)
+{
+    return a >= 0 ? a >> FX_SHIFT : -(-a >> FX_SHIFT);
+}
+
+/**
+ * @brief Multiplies two fixed-point values.
+ * @return a * b, truncated.
+ */
+static inline fixed_t fxMul(fixed_t a, fixed_t b)
+{
+    return (fixed_t)(((int64_t)a * b) >> FX_SHIFT);
+}
+
+/**
+ * @brief Divides two fixed-point values.
+ * @return a / b, truncated toward zero.
+ */
+static inline fixed_t fxDiv(fixed_t a, fixed_t b)
+{
+    return (fixed_t)(((int64_t)a << FX_SHIFT) / b);
+}
+
+/**
+ * @brief Divides an integer by a fixed-point value.
+ *
+ * Unlike fxDiv(fxFromInt(a), b), a may use the whole int32_t range.
+ *
+ * @return a / b, truncated toward zero.
+ */
+static inline fixed_t fxIntDiv(int32_t a, fixed_t b)
+{
+    return (fixed_t)(((int64_t)a << (2 * FX_SHIFT)) / b);
+}
+
+/**
+ * @brief Sine of an angle, from a lookup table.
+ *
+ * The table holds a quarter wave with 256 steps and is interpolated
+ * linearly; the error is below 3e-5 (two units in the last place).
+ *
+ * @param radians Angle in radians.
+ * @return Sine of the angle.
+ */
+fixed_t fxSin(fixed_t radians);
+
+/**
+ * @brief Cosine of an angle, from a lookup table.
+ * @param radians Angle in radians.
+ * @return Cosine of the angle.
+ */
+fixed_t fxCos(fixed_t radians);
+
+#endif // FIXED_MATH_H
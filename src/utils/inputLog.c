@@ -0,0 +1,356 @@
+/**
+ * @file inputLog.c
+ * @brief Implementation for the input recording and replay module.
+ *
+ * Recording and replaying share one buffer: ticks are encoded into it as
+ * they happen, or decoded from it after a log is loaded. A run of ticks
+ * with unchanged axes and no buttons waits in runLength until something
+ * changes (or the log is printed), so idle stretches cost one byte per 128
+ * ticks.
+ */
+
+#include "inputLog.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Longest run a single repeat byte encodes. */
+#define MAX_RUN 128
+
+/** @brief Hexadecimal bytes per "i" line of the text. */
+#define BYTES_PER_LINE 32
+
+/** @brief Hashes per "h" line of the text. */
+#define HASHES_PER_LINE 8
+
+/** @brief Current mode. */
+static InputLogMode mode = INPUT_LOG_IDLE;
+/** @brief Ticks done and hash mismatches. */
+static InputLogResult result;
+
+#if INPUT_LOG_ENABLED
+
+/** @brief Encoded input. */
+static uint8_t bytes[INPUT_LOG_BYTES];
+/** @brief Bytes written (recording) or available (replaying). */
+static uint32_t byteCount = 0;
+/** @brief Next byte to decode. */
+static uint32_t readPosition = 0;
+/** @brief State hash after each tick. */
+static uint32_t hashes[INPUT_LOG_TICKS];
+/** @brief Ticks in the log. */
+static uint32_t tickCount = 0;
+/** @brief Random seed of the run. */
+static uint32_t logSeed = 0;
+/** @brief Axes of the previous tick. */
+static int8_t previousX = 0, previousY = 0;
+/** @brief Ticks of the current run: pending (recording) or left (replaying). */
+static uint32_t runLength = 0;
+
+/**
+ * @brief Clears the buffer and the decoder state.
+ */
+static void resetLog()
+{
+    byteCount = 0;
+    readPosition = 0;
+    tickCount = 0;
+    previousX = 0;
+    previousY = 0;
+    runLength = 0;
+    logSeed = 0;
+    memset(&result, 0, sizeof(result));
+}
+
+/**
+ * @brief Writes the pending run as a repeat byte.
+ */
+static void flushRun()
+{
+    if (runLength > 0)
+    {
+        bytes[byteCount++] = (uint8_t)(runLength - 1);
+        runLength = 0;
+    }
+}
+
+/**
+ * @brief Encodes the input of one tick.
+ * @param tick Input to store.
+ */
+static void recordTick(const InputTick *tick)
+{
+    // Worst case: the pending run plus a token and three operands
+    if (tickCount >= INPUT_LOG_TICKS || byteCount + 5 > INPUT_LOG_BYTES)
+    {
+        flushRun();
+        mode = INPUT_LOG_FINISHED;
+        return;
+    }
+
+    uint8_t token = 0x80;
+    token |= tick->axisX != previousX ? INPUT_LOG_X : 0;
+    token |= tick->axisY != previousY ? INPUT_LOG_Y : 0;
+    token |= tick->pressed ? INPUT_LOG_BUTTONS : 0;
+
+    if (token == 0x80)
+    {
+        if (++runLength == MAX_RUN)
+        {
+            flushRun();
+        }
+        return;
+    }
+
+    flushRun();
+    bytes[byteCount++] = token;
+    if (token & INPUT_LOG_X)
+    {
+        bytes[byteCount++] = (uint8_t)(tick->axisX - previousX);
+    }
+    if (token & INPUT_LOG_Y)
+    {
+        bytes[byteCount++] = (uint8_t)(tick->axisY - previousY);
+    }
+    if (token & INPUT_LOG_BUTTONS)
+    {
+        bytes[byteCount++] = tick->pressed;
+    }
+    previousX = tick->axisX;
+    previousY = tick->axisY;
+}
+
+/**
+ * @brief Decodes the input of one tick.
+ * @param tick Filled with the logged input.
+ */
+static void replayTick(InputTick *tick)
+{
+    tick->pressed = 0;
+    if (runLength == 0 && readPosition < byteCount)
+    {
+        uint8_t token = bytes[readPosition++];
+        if (token & 0x80)
+        {
+            if (token & INPUT_LOG_X)
+            {
+                previousX += (int8_t)bytes[readPosition++];
+            }
+            if (token & INPUT_LOG_Y)
+            {
+                previousY += (int8_t)bytes[readPosition++];
+            }
+            if (token & INPUT_LOG_BUTTONS)
+            {
+                tick->pressed = bytes[readPosition++];
+            }
+        }
+        else
+        {
+            runLength = token + 1;
+        }
+    }
+    if (runLength > 0)
+    {
+        runLength--;
+    }
+    tick->axisX = previousX;
+    tick->axisY = previousY;
+}
+
+/**
+ * @brief Parses a hexadecimal string into bytes.
+ * @param text Hexadecimal digits, two per byte.
+ * @param out Where to write the bytes.
+ * @param capacity Room left in out.
+ * @return Bytes written.
+ */
+static uint32_t parseHex(const char *text, uint8_t *out, uint32_t capacity)
+{
+    uint32_t count = 0;
+    unsigned int value;
+    while (count < capacity && sscanf(text, "%2x", &value) == 1)
+    {
+        out[count++] = (uint8_t)value;
+        text += 2;
+    }
+    return count;
+}
+
+void inputLogStartRecording()
+{
+    resetLog();
+    mode = INPUT_LOG_RECORDING;
+}
+
+bool inputLogStartReplay(FILE *in)
+{
+    char token[128];
+    bool found = false;
+    char section = 0;
+
+    resetLog();
+    while (fscanf(in, "%127s", token) == 1)
+    {
+        if (!strcmp(token, "inputlog"))
+        {
+            // A later log replaces an earlier one
+            resetLog();
+            section = 0;
+            found = false;
+        }
+        else if (!strcmp(token, "s") || !strcmp(token, "i") || !strcmp(token, "h"))
+        {
+            section = token[0];
+        }
+        else if (!strcmp(token, "end"))
+        {
+            found = section != 0;
+            section = 0;
+        }
+        else if (section == 's')
+        {
+            logSeed = (uint32_t)strtoul(token, NULL, 16);
+        }
+        else if (section == 'i')
+        {
+            byteCount += parseHex(token, bytes + byteCount, INPUT_LOG_BYTES - byteCount);
+        }
+        else if (section == 'h' && tickCount < INPUT_LOG_TICKS)
+        {
+            hashes[tickCount++] = (uint32_t)strtoul(token, NULL, 16);
+        }
+    }
+
+    if (!found)
+    {
+        resetLog();
+        mode = INPUT_LOG_IDLE;
+        return false;
+    }
+    mode = tickCount > 0 ? INPUT_LOG_REPLAYING : INPUT_LOG_FINISHED;
+    return true;
+}
+
+uint32_t inputLogSeed(uint32_t seed)
+{
+    if (mode == INPUT_LOG_RECORDING)
+    {
+        logSeed = seed;
+    }
+    else if (mode == INPUT_LOG_REPLAYING)
+    {
+        seed = logSeed;
+    }
+    return seed;
+}
+
+void inputLogTick(InputTick *tick)
+{
+    if (mode == INPUT_LOG_RECORDING)
+    {
+        recordTick(tick);
+    }
+    else if (mode == INPUT_LOG_REPLAYING)
+    {
+        replayTick(tick);
+    }
+}
+
+void inputLogEndTick(uint32_t hash)
+{
+    if (mode == INPUT_LOG_RECORDING)
+    {
+        hashes[tickCount++] = hash;
+        result.ticks = tickCount;
+    }
+    else if (mode == INPUT_LOG_REPLAYING)
+    {
+        if (hash != hashes[result.ticks])
+        {
+            if (result.mismatches++ == 0)
+            {
+                result.firstMismatch = result.ticks;
+            }
+        }
+        if (++result.ticks == tickCount)
+        {
+            mode = INPUT_LOG_FINISHED;
+        }
+    }
+}
+
+void inputLogDump(FILE *out)
+{
+    if (mode == INPUT_LOG_RECORDING)
+    {
+        flushRun();
+    }
+
+    fprintf(out, "inputlog 1 %lu %lu\n", (unsigned long)tickCount, (unsigned long)byteCount);
+    fprintf(out, "s %08lx\n", (unsigned long)logSeed);
+    for (uint32_t i = 0; i < byteCount; i++)
+    {
+        fprintf(out, "%s%02x", i % BYTES_PER_LINE == 0 ? "i " : "", bytes[i]);
+        if (i % BYTES_PER_LINE == BYTES_PER_LINE - 1 || i == byteCount - 1)
+        {
+            fprintf(out, "\n");
+        }
+    }
+    for (uint32_t i = 0; i < tickCount; i++)
+    {
+        fprintf(out, "%s%08lx", i % HASHES_PER_LINE == 0 ? "h " : "", (unsigned long)hashes[i]);
+        fprintf(out, i % HASHES_PER_LINE == HASHES_PER_LINE - 1 || i == tickCount - 1 ? "\n" : " ");
+    }
+    fprintf(out, "end\n");
+}
+
+#else
+
+void inputLogStartRecording()
+{
+}
+
+bool inputLogStartReplay(FILE *in)
+{
+    return false;
+}
+
+uint32_t inputLogSeed(uint32_t seed)
+{
+    return seed;
+}
+
+void inputLogTick(InputTick *tick)
+{
+}
+
+void inputLogEndTick(uint32_t hash)
+{
+}
+
+void inputLogDump(FILE *out)
+{
+}
+
+#endif // INPUT_LOG_ENABLED
+
+InputLogMode inputLogMode()
+{
+    return mode;
+}
+
+const InputLogResult *inputLogResult()
+{
+    return &result;
+}
+
+uint32_t inputLogHash(uint32_t hash, const void *data, uint32_t size)
+{
+    const uint8_t *p = data;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
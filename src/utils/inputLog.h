@@ -0,0 +1,169 @@
+/**
+ * @file inputLog.h
+ * @brief Header file for the input recording and replay module.
+ *
+ * Records the input of every simulation tick (stick axes and the buttons
+ * pressed since the previous tick) together with a hash of the game state
+ * after the tick. Replaying the log feeds the same input back tick by tick
+ * and compares the hashes, so a run can be reproduced bit for bit and used
+ * as a fixed workload to compare builds.
+ *
+ * The inputs are stored as a byte stream: a byte below 0x80 repeats the
+ * previous axes with no buttons for (byte + 1) ticks; a byte with the top
+ * bit set is one tick whose low bits say what follows (INPUT_LOG_X: delta
+ * of the X axis, INPUT_LOG_Y: delta of the Y axis, INPUT_LOG_BUTTONS: mask
+ * of buttons pressed), each one signed or unsigned byte.
+ *
+ * The log is exchanged as text (see inputLogDump), the same on the board's
+ * stdio and in files of the host build. It also holds the random seed the
+ * run was started with, so a replay starts from boot with the same streams.
+ *
+ * Build with INPUT_LOG_ENABLED=1 (CMake option PATROGALAXY_INPUT_LOG) to
+ * turn it on; otherwise the log is never active and uses no memory.
+ */
+
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/** @brief Set to 1 to build the recorder in. */
+#ifndef INPUT_LOG_ENABLED
+#define INPUT_LOG_ENABLED 0
+#endif
+
+/** @brief Most ticks a log holds (4 bytes of hash each). */
+#ifndef INPUT_LOG_TICKS
+#define INPUT_LOG_TICKS 8192
+#endif
+
+/** @brief Most bytes of encoded input a log holds. */
+#ifndef INPUT_LOG_BYTES
+#define INPUT_LOG_BYTES 4096
+#endif
+
+/** @brief Button A was pressed during the tick. */
+#define INPUT_BUTTON_A 0x01
+/** @brief Button B was pressed during the tick. */
+#define INPUT_BUTTON_B 0x02
+
+/** @brief Tick token flag: a delta of the X axis follows. */
+#define INPUT_LOG_X 0x01
+/** @brief Tick token flag: a delta of the Y axis follows. */
+#define INPUT_LOG_Y 0x02
+/** @brief Tick token flag: the buttons pressed follow. */
+#define INPUT_LOG_BUTTONS 0x04
+
+/** @brief Starting value of inputLogHash (FNV-1a offset basis). */
+#define INPUT_LOG_HASH_SEED 2166136261u
+
+/**
+ * @brief Input of one simulation tick.
+ */
+typedef struct
+{
+    int8_t axisX;    /**< X axis, after the deadzone. */
+    int8_t axisY;    /**< Y axis, after the deadzone. */
+    uint8_t pressed; /**< INPUT_BUTTON_* pressed since the previous tick. */
+} InputTick;
+
+/**
+ * @brief What the log is doing.
+ */
+typedef enum
+{
+    INPUT_LOG_IDLE,      /**< Neither recording nor replaying. */
+    INPUT_LOG_RECORDING, /**< Storing the input of every tick. */
+    INPUT_LOG_REPLAYING, /**< Replacing the input of every tick. */
+    INPUT_LOG_FINISHED,  /**< Replay done (or recording full). */
+} InputLogMode;
+
+/**
+ * @brief Outcome of a replay.
+ */
+typedef struct
+{
+    uint32_t ticks;         /**< Ticks replayed or recorded. */
+    uint32_t mismatches;    /**< Ticks whose state hash differed. */
+    uint32_t firstMismatch; /**< First tick that differed, if any. */
+} InputLogResult;
+
+/**
+ * @brief Starts recording from the next tick, discarding any log.
+ */
+void inputLogStartRecording();
+
+/**
+ * @brief Loads a log and replays it from the next tick.
+ *
+ * When the text holds several logs (the board prints one after every
+ * game), the last one is used.
+ *
+ * @param in Text written by inputLogDump.
+ * @return false if no log was found.
+ */
+bool inputLogStartReplay(FILE *in);
+
+/**
+ * @brief Picks the random seed of the run.
+ *
+ * While recording, stores the seed in the log; while replaying, swaps it
+ * for the logged one.
+ *
+ * @param seed Seed the run would use.
+ * @return Seed to use.
+ */
+uint32_t inputLogSeed(uint32_t seed);
+
+/**
+ * @brief Tells what the log is doing.
+ * @return Current mode.
+ */
+InputLogMode inputLogMode();
+
+/**
+ * @brief Whether ticks should report their state hash.
+ * @return true while recording or replaying.
+ */
+static inline bool inputLogActive()
+{
+    InputLogMode mode = inputLogMode();
+    return mode == INPUT_LOG_RECORDING || mode == INPUT_LOG_REPLAYING;
+}
+
+/**
+ * @brief Starts a tick: records its input, or replaces it with the logged one.
+ * @param tick Input sampled for the tick.
+ */
+void inputLogTick(InputTick *tick);
+
+/**
+ * @brief Ends a tick: records the state hash, or checks it against the log.
+ * @param hash Hash of the game state after the tick.
+ */
+void inputLogEndTick(uint32_t hash);
+
+/**
+ * @brief Prints the log as text.
+ * @param out Where to print (stdout sends it over the board's stdio).
+ */
+void inputLogDump(FILE *out);
+
+/**
+ * @brief Reports the ticks done and the hash mismatches found.
+ * @return Result so far.
+ */
+const InputLogResult *inputLogResult();
+
+/**
+ * @brief Adds bytes to a state hash (FNV-1a).
+ * @param hash Hash so far, INPUT_LOG_HASH_SEED to start.
+ * @param data Bytes to add.
+ * @param size Amount of bytes.
+ * @return New hash.
+ */
+uint32_t inputLogHash(uint32_t hash, const void *data, uint32_t size);
+
+#endif // INPUT_LOG_H
@@ -0,0 +1,111 @@
+/**
+ * @file profiler.c
+ * @brief Implementation for the frame profiler module.
+ *
+ * Stages add into the totals of the core they ran on as they finish, so a
+ * stage that runs several times in a frame (catch-up ticks) is summed.
+ * Only core0 closes frames. With PIPELINED_RENDER the raster and flush
+ * stages run on core1: its totals travel back with the frame drawn and are
+ * counted in the frame being simulated when core0 gets it back, one or two
+ * frames behind the others. Neither core ever writes the other's totals.
+ */
+
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+
+/** @brief Stage names, in ProfileStage order, used as CSV columns. */
+static const char *stageNames[PROFILE_STAGE_COUNT] = {"input", "simulation", "raster", "flush"};
+
+/** @brief Last frames, oldest at ringHead once the ring is full. */
+static ProfileFrame ring[PROFILER_FRAMES];
+/** @brief Next entry of the ring to write. */
+static uint32_t ringHead = 0;
+/** @brief Amount of valid entries in the ring. */
+static uint32_t ringCount = 0;
+/** @brief Frame being measured; its stages are core0's totals. */
+static ProfileFrame current;
+/** @brief Totals of core1 not handed off yet. */
+static ProfileStages core1Stages;
+/** @brief End of the previous frame, 0 before the first one. */
+static uint64_t lastFrameEndUs = 0;
+
+void profilerRecord(ProfileStage stage, uint32_t us)
+{
+    if (get_core_num() == 0)
+    {
+        current.stageUs[stage] += us;
+    }
+    else
+    {
+        core1Stages.stageUs[stage] += us;
+    }
+}
+
+void profilerHandOff(ProfileStages *stages)
+{
+    *stages = core1Stages;
+    memset(&core1Stages, 0, sizeof(core1Stages));
+}
+
+void profilerMerge(const ProfileStages *stages)
+{
+    for (int s = 0; s < PROFILE_STAGE_COUNT; s++)
+    {
+        current.stageUs[s] += stages->stageUs[s];
+    }
+}
+
+void profilerEndFrame()
+{
+    uint64_t now = time_us_64();
+    current.totalUs = lastFrameEndUs ? (uint32_t)(now - lastFrameEndUs) : 0;
+    lastFrameEndUs = now;
+
+    ring[ringHead] = current;
+    ringHead = (ringHead + 1) % PROFILER_FRAMES;
+    if (ringCount < PROFILER_FRAMES)
+    {
+        ringCount++;
+    }
+
+    uint32_t frame = current.frame + 1;
+    memset(&current, 0, sizeof(current));
+    current.frame = frame;
+}
+
+void profilerPoll()
+{
+    int c = getchar_timeout_us(0);
+    if (c == PROFILER_DUMP_COMMAND)
+    {
+        profilerDump();
+    }
+}
+
+void profilerDump()
+{
+    printf("frame,total");
+    for (int s = 0; s < PROFILE_STAGE_COUNT; s++)
+    {
+        printf(",%s", stageNames[s]);
+    }
+    printf("\n");
+
+    uint32_t first = (ringHead + PROFILER_FRAMES - ringCount) % PROFILER_FRAMES;
+    for (uint32_t i = 0; i < ringCount; i++)
+    {
+        const ProfileFrame *f = &ring[(first + i) % PROFILER_FRAMES];
+        printf("%lu,%lu", (unsigned long)f->frame, (unsigned long)f->totalUs);
+        for (int s = 0; s < PROFILE_STAGE_COUNT; s++)
+        {
+            printf(",%lu", (unsigned long)f->stageUs[s]);
+        }
+        printf("\n");
+    }
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,133 @@
+/**
+ * @file profiler.h
+ * @brief Header file for the frame profiler module.
+ *
+ * Measures how long each stage of a frame takes with the microsecond timer
+ * and keeps the last PROFILER_FRAMES frames in a ring buffer. Sending
+ * PROFILER_DUMP_COMMAND over the stdio (USB or UART) prints the buffer as
+ * CSV.
+ *
+ * Build with PROFILER_ENABLED=1 (CMake option PATROGALAXY_PROFILER) to turn
+ * it on; otherwise every macro expands to nothing and no code or memory is
+ * used.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+/** @brief Set to 1 to build the profiler in. */
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+/** @brief Frames kept in the ring buffer. */
+#define PROFILER_FRAMES 128
+
+/** @brief Character that requests the CSV dump on stdio. */
+#define PROFILER_DUMP_COMMAND 'p'
+
+/**
+ * @brief Stages of a frame.
+ */
+typedef enum
+{
+    PROFILE_STAGE_INPUT,      /**< Reading the analog stick. */
+    PROFILE_STAGE_SIMULATION, /**< Simulation ticks (includes input). */
+    PROFILE_STAGE_RASTER,     /**< Drawing the frame into the buffer. */
+    PROFILE_STAGE_FLUSH,      /**< Sending the buffer to the display. */
+    PROFILE_STAGE_COUNT       /**< Amount of stages. */
+} ProfileStage;
+
+/**
+ * @brief Time spent in each stage, handed from core1 to core0.
+ */
+typedef struct
+{
+    uint32_t stageUs[PROFILE_STAGE_COUNT]; /**< Time spent in each stage. */
+} ProfileStages;
+
+/**
+ * @brief Timings of one frame.
+ */
+typedef struct
+{
+    uint32_t frame;                        /**< Frame number. */
+    uint32_t totalUs;                      /**< Time since the previous frame ended. */
+    uint32_t stageUs[PROFILE_STAGE_COUNT]; /**< Time spent in each stage. */
+} ProfileFrame;
+
+#if PROFILER_ENABLED
+
+#include "pico/stdlib.h"
+
+/**
+ * @brief Adds time to a stage, on the calling core.
+ *
+ * Each core adds into its own totals. Core0's go into the current frame;
+ * core1's wait there until handed off with profilerHandOff.
+ *
+ * @param stage Stage measured.
+ * @param us Microseconds spent.
+ */
+void profilerRecord(ProfileStage stage, uint32_t us);
+
+/**
+ * @brief Moves the calling core's totals out, to travel with a frame.
+ *
+ * Called on core1 before it hands a frame back to core0.
+ *
+ * @param stages Receives the totals.
+ */
+void profilerHandOff(ProfileStages *stages);
+
+/**
+ * @brief Adds totals handed off by core1 to the current frame.
+ *
+ * Called on core0 once the frame carrying them is back.
+ *
+ * @param stages Totals from profilerHandOff.
+ */
+void profilerMerge(const ProfileStages *stages);
+
+/**
+ * @brief Closes the current frame and stores it in the ring buffer.
+ */
+void profilerEndFrame();
+
+/**
+ * @brief Checks stdio for the dump command, without blocking.
+ */
+void profilerPoll();
+
+/**
+ * @brief Prints the ring buffer as CSV, oldest frame first.
+ */
+void profilerDump();
+
+/** @brief Starts measuring a stage; pair with PROFILE_END in the same scope. */
+#define PROFILE_BEGIN(stage) uint64_t profileStart_##stage = time_us_64()
+/** @brief Stops measuring a stage and adds the time to the current frame. */
+#define PROFILE_END(stage) profilerRecord(stage, (uint32_t)(time_us_64() - profileStart_##stage))
+/** @brief Moves core1's stage times out with a frame handed back. */
+#define PROFILE_HAND_OFF(stages) profilerHandOff(stages)
+/** @brief Adds the stage times of a frame handed back to the current frame. */
+#define PROFILE_MERGE(stages) profilerMerge(stages)
+/** @brief Closes the current frame. */
+#define PROFILE_FRAME_END() profilerEndFrame()
+/** @brief Dumps the timings if the command was received. */
+#define PROFILE_POLL() profilerPoll()
+
+#else
+
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END(stage) ((void)0)
+#define PROFILE_HAND_OFF(stages) ((void)(stages))
+#define PROFILE_MERGE(stages) ((void)(stages))
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_POLL() ((void)0)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
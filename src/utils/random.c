@@ -0,0 +1,67 @@
+/**
+ * @file random.c
+ * @brief Implementation for the random number generator module.
+ */
+
+#include "random.h"
+
+#ifndef RANDOM_FIXED_SEED
+#include "hardware/adc.h"
+#include "hardware/structs/rosc.h"
+#endif
+
+/** @brief Input of the ADC temperature sensor. */
+#define TEMPERATURE_INPUT 4
+
+/** @brief Streams before randomSeed is called: valid, but always the same. */
+uint32_t randomStates[RANDOM_STREAMS] = {0x2545F491u, 0x9E3779B9u, 0x6C078965u};
+
+/**
+ * @brief Scrambles a value (the finalizer of MurmurHash3).
+ * @param x Value to scramble.
+ * @return Scrambled value.
+ */
+static uint32_t mix(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+void randomSeed(uint32_t seed)
+{
+    for (int i = 0; i < RANDOM_STREAMS; i++)
+    {
+        uint32_t state = mix(seed + 0x9E3779B9u * (i + 1));
+        randomStates[i] = state ? state : 0x2545F491u;
+    }
+}
+
+uint32_t randomEntropySeed()
+{
+#ifdef RANDOM_FIXED_SEED
+    return RANDOM_FIXED_SEED;
+#else
+    uint32_t seed = 0;
+
+    // The ring oscillator jitters against the system clock
+    for (int i = 0; i < 32; i++)
+    {
+        seed = (seed << 1) | (rosc_hw->randombit & 1);
+    }
+
+    // The temperature sensor's last bit is noise
+    adc_set_temp_sensor_enabled(true);
+    adc_select_input(TEMPERATURE_INPUT);
+    for (int i = 0; i < 32; i++)
+    {
+        seed = mix(seed ^ (adc_read() & 1));
+    }
+    adc_set_temp_sensor_enabled(false);
+
+    return seed;
+#endif
+}
@@ -0,0 +1,93 @@
+/**
+ * @file random.h
+ * @brief Header file for the random number generator module.
+ *
+ * Every subsystem draws from its own xorshift32 stream, so adding a random
+ * call in one place does not change what another one sees, and a single
+ * seed reproduces a whole run. The generator is only shifts and XORs, and
+ * randomBelow maps into a range with a 16x16 multiply instead of `%`: the
+ * Cortex-M0+ has no divide instruction.
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Independent random streams, one per subsystem.
+ */
+typedef enum
+{
+    RANDOM_SPAWNS,    /**< Asteroid positions and angles. */
+    RANDOM_STARS,     /**< Background stars. */
+    RANDOM_PARTICLES, /**< Ship exhaust particles. */
+    RANDOM_STREAMS    /**< Amount of streams. */
+} RandomStream;
+
+/** @brief State of each stream (never 0). */
+extern uint32_t randomStates[RANDOM_STREAMS];
+
+/**
+ * @brief Seeds every stream from one value.
+ *
+ * The same seed always gives the same streams. Each stream starts from a
+ * different mix of the seed, so they don't follow each other.
+ *
+ * @param seed Any value, 0 included.
+ */
+void randomSeed(uint32_t seed);
+
+/**
+ * @brief Gathers a seed from hardware noise.
+ *
+ * Reads the ring oscillator's random bit and the low bits of the ADC
+ * temperature sensor (the ADC must be initialized). Builds defining
+ * RANDOM_FIXED_SEED return that value instead, for reproducible runs.
+ *
+ * @return Seed for randomSeed.
+ */
+uint32_t randomEntropySeed();
+
+/**
+ * @brief Draws the next value of a stream.
+ * @param stream Stream to draw from.
+ * @return 32 random bits.
+ */
+static inline uint32_t randomNext(RandomStream stream)
+{
+    uint32_t x = randomStates[stream];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    randomStates[stream] = x;
+    return x;
+}
+
+/**
+ * @brief Draws a value in [0, bound).
+ *
+ * Scales the top 16 bits by the bound, so it needs no division.
+ *
+ * @param stream Stream to draw from.
+ * @param bound Amount of possible values, at most 65536.
+ * @return Random value below bound.
+ */
+static inline uint32_t randomBelow(RandomStream stream, uint32_t bound)
+{
+    return ((randomNext(stream) >> 16) * bound) >> 16;
+}
+
+/**
+ * @brief Draws a value in [min, max].
+ * @param stream Stream to draw from.
+ * @param min Smallest value.
+ * @param max Largest value, at most min + 65535.
+ * @return Random value between min and max.
+ */
+static inline int32_t randomRange(RandomStream stream, int32_t min, int32_t max)
+{
+    return min + (int32_t)randomBelow(stream, (uint32_t)(max - min + 1));
+}
+
+#endif // RANDOM_H
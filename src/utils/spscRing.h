@@ -0,0 +1,64 @@
+/**
+ * @file spscRing.h
+ * @brief Lock-free single-producer single-consumer rings.
+ *
+ * SPSC_RING(Type, prefix, Item, capacity) declares a ring of Item and its
+ * functions, prefixed with prefix:
+ * - prefixPush adds an item on the producer side; false if the ring is full.
+ * - prefixPop takes the oldest item on the consumer side; false if empty.
+ *
+ * Only the producer moves the head and only the consumer moves the tail,
+ * each publishing with a release store after touching the items, so one
+ * side may be an interrupt or the other core. Nothing blocks or disables
+ * interrupts; a blocking wait is up to the caller (see renderWorker.c).
+ * A ring of all zeros is empty and ready to use.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+/**
+ * @brief Declares a ring type and its functions.
+ * @param Type Name of the ring struct.
+ * @param prefix Prefix of its functions.
+ * @param Item Type of the items.
+ * @param capacity Most items waiting at once (a power of two).
+ */
+#define SPSC_RING(Type, prefix, Item, capacity)                                                   \
+    _Static_assert(((capacity) & ((capacity) - 1)) == 0, #Type " capacity must be a power of two"); \
+                                                                                                  \
+    typedef struct                                                                                \
+    {                                                                                             \
+        Item items[capacity]; /**< Items, indexed by count modulo capacity. */                    \
+        atomic_uint head;     /**< Items ever pushed; written by the producer only. */            \
+        atomic_uint tail;     /**< Items ever popped; written by the consumer only. */            \
+    } Type;                                                                                       \
+                                                                                                  \
+    /** @brief Adds an item. Returns false, dropping it, if the ring is full. */                  \
+    static inline bool prefix##Push(Type *ring, Item item)                                        \
+    {                                                                                             \
+        unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);                  \
+        unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);                  \
+        if (head - tail == (capacity))                                                            \
+            return false;                                                                         \
+        ring->items[head & ((capacity) - 1)] = item;                                              \
+        atomic_store_explicit(&ring->head, head + 1, memory_order_release);                       \
+        return true;                                                                              \
+    }                                                                                             \
+                                                                                                  \
+    /** @brief Takes the oldest item. Returns false if the ring is empty. */                      \
+    static inline bool prefix##Pop(Type *ring, Item *item)                                        \
+    {                                                                                             \
+        unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);                  \
+        unsigned head = atomic_load_explicit(&ring->head, memory_order_acquire);                  \
+        if (tail == head)                                                                         \
+            return false;                                                                         \
+        *item = ring->items[tail & ((capacity) - 1)];                                             \
+        atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);                       \
+        return true;                                                                              \
+    }
+
+#endif // SPSC_RING_H
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Convert a monochrome image into a page-packed SSD1306 C header.
+
+Reads a 1-bit uncompressed BMP or a PBM (P1/P4) and writes a header with a
+`const` array in the panel's native layout: one byte per column per page of
+8 rows, least significant bit on top. Dark pixels are lit, which matches
+what ssd1306_bmp_show_image does with the same BMP.
+
+Usage: pack_image.py <input.bmp|input.pbm> <output.h> <symbol>
+"""
+
+import struct
+import sys
+
+
+def read_bmp(data):
+    """Returns (width, height, rows) where rows[y][x] is True for lit pixels."""
+    if data[:2] != b"BM":
+        raise ValueError("not a BMP file")
+
+    off_bits = struct.unpack_from("<I", data, 10)[0]
+    header_size = struct.unpack_from("<I", data, 14)[0]
+    width, height = struct.unpack_from("<ii", data, 18)
+    bit_count = struct.unpack_from("<H", data, 28)[0]
+    compression = struct.unpack_from("<I", data, 30)[0]
+
+    if bit_count != 1:
+        raise ValueError("image is not monochrome")
+    if compression != 0:
+        raise ValueError("image is compressed")
+
+    # The palette entry that is black is the one drawn.
+    table = 14 + header_size
+    lit_index = 0
+    for index in range(2):
+        blue, green, red = data[table + 4 * index:table + 4 * index + 3]
+        if (red, green, blue) == (0, 0, 0):
+            lit_index = index
+            break
+
+    bottom_up = height > 0
+    height = abs(height)
+    stride = ((width + 31) // 32) * 4
+
+    rows = []
+    for y in range(height):
+        line = off_bits + stride * ((height - 1 - y) if bottom_up else y)
+        rows.append([((data[line + x // 8] >> (7 - x % 8)) & 1) == lit_index for x in range(width)])
+    return width, height, rows
+
+
+def read_pbm(data):
+    """Returns (width, height, rows) for a plain (P1) or raw (P4) PBM."""
+    tokens = []
+    pos = 0
+
+    def next_token():
+        nonlocal pos
+        while True:
+            while pos < len(data) and data[pos:pos + 1].isspace():
+                pos += 1
+            if data[pos:pos + 1] == b"#":
+                while pos < len(data) and data[pos:pos + 1] not in (b"\n", b"\r"):
+                    pos += 1
+                continue
+            break
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        return data[start:pos]
+
+    magic = next_token()
+    width = int(next_token())
+    height = int(next_token())
+
+    if magic == b"P4":
+        pos += 1  # Single whitespace before the raster
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = pos + stride * y
+            rows.append([((data[line + x // 8] >> (7 - x % 8)) & 1) == 1 for x in range(width)])
+        return width, height, rows
+
+    if magic == b"P1":
+        bits = [c for c in data[pos:] if c in b"01"]
+        rows = [[bits[y * width + x] == ord("1") for x in range(width)] for y in range(height)]
+        return width, height, rows
+
+    raise ValueError("unsupported PBM format %r" % magic)
+
+
+def pack_pages(width, height, rows):
+    """Packs the rows into pages of vertical bytes, page by page."""
+    pages = (height + 7) // 8
+    packed = bytearray(pages * width)
+    for y in range(height):
+        for x in range(width):
+            if rows[y][x]:
+                packed[(y // 8) * width + x] |= 1 << (y % 8)
+    return packed
+
+
+def write_header(path, symbol, source, width, height, packed):
+    guard = symbol.upper() + "_IMAGE_H"
+    lines = [
+        "/* Generated by tools/pack_image.py from %s. Do not edit. */" % source,
+        "",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        '#include "ssd1306.h"',
+        "",
+        "static const uint8_t %s_pages[%d] = {" % (symbol, len(packed)),
+    ]
+    for start in range(0, len(packed), 16):
+        chunk = packed[start:start + 16]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines += [
+        "};",
+        "",
+        "static const ssd1306_image_t %s_image = {" % symbol,
+        "    .width = %d," % width,
+        "    .height = %d," % height,
+        "    .data = %s_pages," % symbol,
+        "};",
+        "",
+        "#endif // %s" % guard,
+        "",
+    ]
+    with open(path, "w") as out:
+        out.write("\n".join(lines))
+
+
+def main(argv):
+    if len(argv) != 4:
+        sys.stderr.write(__doc__)
+        return 1
+
+    source, output, symbol = argv[1:]
+    with open(source, "rb") as f:
+        data = f.read()
+
+    if data[:2] == b"BM":
+        width, height, rows = read_bmp(data)
+    else:
+        width, height, rows = read_pbm(data)
+
+    if width > 255 or height > 255:
+        raise ValueError("image larger than 255x255")
+
+    name = source.replace("\\", "/").split("/")[-1]
+    write_header(output, symbol, name, width, height, pack_pages(width, height, rows))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))